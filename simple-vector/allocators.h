@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+
+// Монотонная арена: выделяет память последовательно из крупных блоков
+// и никогда не освобождает её поштучно. Вся память арены освобождается
+// разом вызовом Release() или в деструкторе.
+// Арена не потокобезопасна — она рассчитана на один запрос в одном потоке
+class MonotonicArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit MonotonicArena(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept
+    : block_size_(std::max(block_size, sizeof(Block))) {
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() {
+        Release();
+    }
+
+    // Выделяет bytes байт с выравниванием alignment (степень двойки)
+    void* Allocate(size_t bytes, size_t alignment) {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+        std::uintptr_t aligned = AlignUp(reinterpret_cast<std::uintptr_t>(current_), alignment);
+        if (current_ == nullptr || aligned + bytes > reinterpret_cast<std::uintptr_t>(end_)) {
+            AddBlock(bytes + alignment);
+            aligned = AlignUp(reinterpret_cast<std::uintptr_t>(current_), alignment);
+        }
+        current_ = reinterpret_cast<char*>(aligned + bytes);
+        bytes_allocated_ += bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Освобождает все блоки арены. Объекты в выделенной памяти
+    // к этому моменту должны быть разрушены
+    void Release() noexcept {
+        while (head_) {
+            Block* next = head_->next;
+            ::operator delete(head_);
+            head_ = next;
+        }
+        current_ = nullptr;
+        end_ = nullptr;
+        bytes_allocated_ = 0;
+    }
+
+    // Возвращает количество байт, выданных арене с момента последнего Release()
+    size_t GetBytesAllocated() const noexcept {
+        return bytes_allocated_;
+    }
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    static std::uintptr_t AlignUp(std::uintptr_t value, size_t alignment) noexcept {
+        return (value + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+    }
+
+    // Добавляет блок, в который помещается хотя бы min_bytes байт
+    void AddBlock(size_t min_bytes) {
+        const size_t size = std::max(block_size_, min_bytes + sizeof(Block));
+        Block* block = static_cast<Block*>(::operator new(size));
+        block->next = head_;
+        head_ = block;
+        current_ = reinterpret_cast<char*>(block + 1);
+        end_ = reinterpret_cast<char*>(block) + size;
+    }
+
+    size_t block_size_;
+    Block* head_ = nullptr;
+    char* current_ = nullptr;
+    char* end_ = nullptr;
+    size_t bytes_allocated_ = 0;
+};
+
+// Пул блоков фиксированных классов размера (16, 32, ..., MAX_CLASS_SIZE байт).
+// Освобождённые блоки попадают в список свободных блоков своего класса
+// и переиспользуются без обращения к глобальному аллокатору.
+// Запросы больше MAX_CLASS_SIZE обслуживаются напрямую через operator new.
+// Release() возвращает всю память классов разом.
+// Пул не потокобезопасен
+class FixedSizePool {
+public:
+    static constexpr size_t MIN_CLASS_SIZE = 16;
+    static constexpr size_t MAX_CLASS_SIZE = 4096;
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    FixedSizePool() noexcept = default;
+
+    FixedSizePool(const FixedSizePool&) = delete;
+    FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+    ~FixedSizePool() {
+        Release();
+    }
+
+    // Выделяет bytes байт с выравниванием alignment
+    void* Allocate(size_t bytes, size_t alignment) {
+        if (bytes > MAX_CLASS_SIZE || alignment > alignof(std::max_align_t)) {
+            return ::operator new(bytes, std::align_val_t{alignment});
+        }
+        const size_t class_index = ClassIndex(bytes);
+        FreeNode*& free_list = free_lists_[class_index];
+        if (free_list == nullptr) {
+            Refill(class_index);
+        }
+        FreeNode* node = free_list;
+        free_list = node->next;
+        return node;
+    }
+
+    // Возвращает блок в пул. bytes и alignment должны совпадать с переданными в Allocate
+    void Deallocate(void* ptr, size_t bytes, size_t alignment) noexcept {
+        if (bytes > MAX_CLASS_SIZE || alignment > alignof(std::max_align_t)) {
+            ::operator delete(ptr, std::align_val_t{alignment});
+            return;
+        }
+        FreeNode*& free_list = free_lists_[ClassIndex(bytes)];
+        free_list = new (ptr) FreeNode{free_list};
+    }
+
+    // Освобождает всю память классов размера. Блоки больше MAX_CLASS_SIZE
+    // не затрагиваются — их освобождает Deallocate
+    void Release() noexcept {
+        while (chunks_) {
+            Chunk* next = chunks_->next;
+            ::operator delete(chunks_);
+            chunks_ = next;
+        }
+        std::fill(std::begin(free_lists_), std::end(free_lists_), nullptr);
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+    };
+
+    static constexpr size_t CLASS_COUNT = 9;  // 16 << 8 == 4096
+
+    // Номер наименьшего класса, в который помещается bytes байт
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t index = 0;
+        for (size_t class_size = MIN_CLASS_SIZE; class_size < bytes; class_size <<= 1) {
+            ++index;
+        }
+        return index;
+    }
+
+    // Нарезает новый чанк на блоки класса class_index и кладёт их в список свободных
+    void Refill(size_t class_index) {
+        const size_t class_size = MIN_CLASS_SIZE << class_index;
+        char* raw = static_cast<char*>(::operator new(CHUNK_SIZE));
+        Chunk* chunk = new (raw) Chunk{chunks_};
+        chunks_ = chunk;
+
+        FreeNode*& free_list = free_lists_[class_index];
+        for (size_t offset = sizeof(Chunk); offset + class_size <= CHUNK_SIZE; offset += class_size) {
+            free_list = new (raw + offset) FreeNode{free_list};
+        }
+    }
+
+    Chunk* chunks_ = nullptr;
+    FreeNode* free_lists_[CLASS_COUNT] = {};
+};
+
+// Аллокатор в модели std::allocator_traits, выделяющий память из MonotonicArena.
+// deallocate ничего не делает: память возвращается вместе со всей ареной
+template <typename Type>
+class ArenaAllocator {
+public:
+    using value_type = Type;
+
+    explicit ArenaAllocator(MonotonicArena& arena) noexcept
+    : arena_(&arena) {
+    }
+
+    template <typename Other>
+    ArenaAllocator(const ArenaAllocator<Other>& other) noexcept
+    : arena_(other.GetArena()) {
+    }
+
+    Type* allocate(size_t n) {
+        return static_cast<Type*>(arena_->Allocate(n * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type*, size_t) noexcept {
+    }
+
+    MonotonicArena* GetArena() const noexcept {
+        return arena_;
+    }
+
+private:
+    MonotonicArena* arena_;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// Аллокатор в модели std::allocator_traits, выделяющий память из FixedSizePool
+template <typename Type>
+class PoolAllocator {
+public:
+    using value_type = Type;
+
+    explicit PoolAllocator(FixedSizePool& pool) noexcept
+    : pool_(&pool) {
+    }
+
+    template <typename Other>
+    PoolAllocator(const PoolAllocator<Other>& other) noexcept
+    : pool_(other.GetPool()) {
+    }
+
+    Type* allocate(size_t n) {
+        return static_cast<Type*>(pool_->Allocate(n * sizeof(Type), alignof(Type)));
+    }
+
+    void deallocate(Type* ptr, size_t n) noexcept {
+        pool_->Deallocate(ptr, n * sizeof(Type), alignof(Type));
+    }
+
+    FixedSizePool* GetPool() const noexcept {
+        return pool_;
+    }
+
+private:
+    FixedSizePool* pool_;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const PoolAllocator<Lhs>& lhs, const PoolAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetPool() == rhs.GetPool();
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const PoolAllocator<Lhs>& lhs, const PoolAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
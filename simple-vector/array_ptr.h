@@ -3,76 +3,128 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
-template <typename Type>
+#include "checked_iterator.h"
+
+// В C++20 аллокатор и создание объектов доступны при вычислении на этапе компиляции,
+// и ArrayPtr и SimpleVector объявляются constexpr. В C++17 макрос пуст
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && __cpp_lib_constexpr_dynamic_alloc >= 201907L
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#define SIMPLE_VECTOR_HAS_CONSTEXPR 1
+#else
+#define SIMPLE_VECTOR_CONSTEXPR
+#endif
+
+// Выполняется ли код на этапе компиляции. Ветки с memcpy, SIMD и инструментированием
+// там недоступны и заменяются поэлементными
+constexpr bool IsConstantEvaluated() noexcept {
+#ifdef SIMPLE_VECTOR_HAS_CONSTEXPR
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// Умеет ли аллокатор расширять выделенный блок на месте:
+// bool expand(Type* ptr, size_t old_n, size_t new_n)
+template <typename Type, typename Allocator, typename = void>
+struct AllocatorCanExpand : std::false_type {
+};
+
+template <typename Type, typename Allocator>
+struct AllocatorCanExpand<Type, Allocator, std::void_t<decltype(std::declval<Allocator&>().expand(
+                                               std::declval<Type*>(), size_t{}, size_t{}))>>
+    : std::true_type {
+};
+
+// Владеет неинициализированной памятью под массив элементов типа Type,
+// выделенной аллокатором Allocator через std::allocator_traits.
+// ArrayPtr не создаёт и не разрушает объекты — временем их жизни
+// управляет владелец (например, SimpleVector)
+template <typename Type, typename Allocator = std::allocator<Type>>
 class ArrayPtr {
 public:
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
     // Инициализирует ArrayPtr нулевым указателем
     ArrayPtr() = default;
 
-    // Создаёт в куче массив из size элементов типа Type.
+    // Инициализирует ArrayPtr нулевым указателем с заданным аллокатором
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(const Allocator& alloc) noexcept
+    : alloc_(alloc) {
+    }
+
+    // Выделяет память под size элементов типа Type, не создавая их.
     // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size) {
-        Type* numbers = new Type[size]; 
-        if (size == 0) {
-            raw_ptr_ = nullptr;
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t size, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        if (size != 0) {
+            raw_ptr_ = AllocatorTraits::allocate(alloc_, size);
+            size_ = size;
         }
-        else {
-           raw_ptr_ = numbers;
-        }
-        
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept 
-    : raw_ptr_(raw_ptr) {
+    // Конструктор из сырого указателя на память под size элементов,
+    // выделенную аллокатором alloc, либо nullptr
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(Type* raw_ptr, size_t size, const Allocator& alloc = Allocator()) noexcept
+    : raw_ptr_(raw_ptr), size_(raw_ptr ? size : 0), alloc_(alloc) {
     }
 
     // Запрещаем копирование
     ArrayPtr(const ArrayPtr&) = delete;
 
     // Конструктор перемещения
-    ArrayPtr(ArrayPtr&& other) noexcept : raw_ptr_(other.raw_ptr_) {
-        other.raw_ptr_ = nullptr;  // Обнуляем указатель в другом объекте
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(ArrayPtr&& other) noexcept
+    : raw_ptr_(std::exchange(other.raw_ptr_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      alloc_(std::move(other.alloc_)) {
     }
 
-    ~ArrayPtr() {
-        delete[] raw_ptr_;
+    // Освобождает память. Объекты в ней к этому моменту должны быть разрушены владельцем
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr() {
+        Deallocate();
     }
 
     // Запрещаем присваивание
     ArrayPtr& operator=(const ArrayPtr&) = delete;
 
-    ArrayPtr& operator=(ArrayPtr&& other) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& other) noexcept {
         if (this != &other) {
+            Deallocate();
             raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            alloc_ = std::move(other.alloc_);
         }
         return *this;
     }
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
-    // После вызова метода указатель на массив должен обнулиться
-    [[nodiscard]] Type* Release() noexcept {
-        Type* old_pointer = raw_ptr_;
-        raw_ptr_ = nullptr;
-        return old_pointer;
+    // После вызова метода указатель на массив должен обнулиться.
+    // Освобождать полученную память нужно аллокатором GetAllocator()
+    [[nodiscard]] SIMPLE_VECTOR_CONSTEXPR Type* Release() noexcept {
+        size_ = 0;
+        return std::exchange(raw_ptr_, nullptr);
     }
 
     // Возвращает ссылку на элемент массива с индексом index
-    Type& operator[](size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "ArrayPtr index is out of range");
         Type* indexed = raw_ptr_ + index;
         return *indexed;
     }
 
     // Возвращает константную ссылку на элемент массива с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "ArrayPtr index is out of range");
         const Type* indexed = raw_ptr_ + index;
         return *indexed;
     }
 
     // Возвращает true, если указатель ненулевой, и false в противном случае
-    explicit operator bool() const {
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const {
         if (raw_ptr_) {
             return true;
         }
@@ -80,15 +132,51 @@ public:
     }
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
-    Type* Get() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type* Get() const noexcept {
         return raw_ptr_;
     }
 
-    // Обменивается значениям указателя на массив с объектом other
-    void swap(ArrayPtr& other) noexcept {
-        std::swap(raw_ptr_, other.raw_ptr_);
+    // Возвращает количество элементов, под которые выделена память
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Пытается увеличить массив до new_size элементов без переноса в другую память.
+    // Возвращает true, если аллокатор расширил блок на месте
+    SIMPLE_VECTOR_CONSTEXPR bool TryExpand(size_t new_size) noexcept {
+        if constexpr (AllocatorCanExpand<Type, Allocator>::value) {
+            if (raw_ptr_ && alloc_.expand(raw_ptr_, size_, new_size)) {
+                size_ = new_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Allocator& GetAllocator() noexcept {
+        return alloc_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Allocator& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Обменивается значениям указателя на массив и аллокатором с объектом other
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr& other) noexcept {
+        using std::swap;
+        swap(raw_ptr_, other.raw_ptr_);
+        swap(size_, other.size_);
+        swap(alloc_, other.alloc_);
     }
 
 private:
+    SIMPLE_VECTOR_CONSTEXPR void Deallocate() noexcept {
+        if (raw_ptr_) {
+            AllocatorTraits::deallocate(alloc_, raw_ptr_, size_);
+        }
+    }
+
     Type* raw_ptr_ = nullptr;
-};
\ No newline at end of file
+    size_t size_ = 0;
+    [[no_unique_address]] Allocator alloc_{};
+};
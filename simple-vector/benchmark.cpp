@@ -0,0 +1,1827 @@
+#include "concurrent_simple_vector.h"
+#include "cow_simple_vector.h"
+#include "flat_map.h"
+#include "gap_buffer.h"
+#include "mmap_allocator.h"
+#include "packed_vector.h"
+#include "parallel.h"
+#include "pipeline.h"
+#include "prefetch_iterator.h"
+#include "segmented_vector.h"
+#include "simple_vector.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
+#include "test_types.h"
+#include "vector_io.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Счётчики обращений к куче. Глобальные operator new/delete ниже считают все выделения
+// программы, поэтому SimpleVector и std::vector сравниваются одинаково
+atomic<size_t> heap_allocations{0};
+atomic<size_t> heap_bytes{0};
+
+void* operator new(size_t size) {
+    heap_allocations.fetch_add(1, memory_order_relaxed);
+    heap_bytes.fetch_add(size, memory_order_relaxed);
+    if (void* ptr = malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw bad_alloc();
+}
+
+// GCC не знает, что operator new выше выделяет через malloc, и предупреждает о free
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+#pragma GCC diagnostic pop
+
+// Аппаратный счётчик perf_event для текущего потока.
+// Если счётчик недоступен (нет прав, виртуальная машина), Stop() возвращает -1
+class PerfCounter {
+public:
+    PerfCounter(uint32_t type, uint64_t config) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    ~PerfCounter() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    bool IsAvailable() const {
+        return fd_ >= 0;
+    }
+
+    void Start() {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    long long Stop() {
+        if (fd_ < 0) {
+            return -1;
+        }
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (read(fd_, &value, sizeof(value)) != sizeof(value)) {
+            return -1;
+        }
+        return value;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+constexpr uint64_t CacheEvent(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+// Одна запись JSON-отчёта. Поля выводятся в порядке добавления
+class JsonRecord {
+public:
+    JsonRecord& Add(const string& key, const string& value) {
+        fields_.emplace_back(key, Quote(value));
+        return *this;
+    }
+
+    JsonRecord& Add(const string& key, double value) {
+        if (!isfinite(value)) {
+            fields_.emplace_back(key, "null"s);
+            return *this;
+        }
+        ostringstream out;
+        out.precision(10);
+        out << value;
+        fields_.emplace_back(key, out.str());
+        return *this;
+    }
+
+    // Значение счётчика perf_event; отрицательное означает «недоступен» и пишется как null
+    JsonRecord& AddCounter(const string& key, double value) {
+        return Add(key, value < 0 ? NAN : value);
+    }
+
+    JsonRecord& SetName(const string& name) {
+        return Add("name"s, name);
+    }
+
+    string ToString() const {
+        string result = "{"s;
+        for (size_t i = 0; i < fields_.size(); ++i) {
+            result += (i == 0 ? ""s : ", "s) + Quote(fields_[i].first) + ": "s + fields_[i].second;
+        }
+        return result + "}"s;
+    }
+
+    static string Quote(const string& value) {
+        string result = "\""s;
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+                result += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                result += escaped;
+            } else {
+                result += c;
+            }
+        }
+        return result + "\""s;
+    }
+
+private:
+    vector<pair<string, string>> fields_;
+};
+
+struct Options {
+    string filter;
+    string out_path;
+    bool quick = false;
+
+    // Размер задачи: в режиме --quick в 100 раз меньше, чтобы прогон занимал секунды
+    size_t Scaled(size_t n) const {
+        return quick ? max<size_t>(n / 100, 1) : n;
+    }
+};
+
+// Собирает записи и печатает их одним JSON-документом, как Google Benchmark:
+// {"context": {...}, "benchmarks": [...]}
+class JsonReporter {
+public:
+    void Report(const JsonRecord& record) {
+        cerr << "  "s << record.ToString() << endl;
+        records_.push_back(record);
+    }
+
+    void Write(ostream& out, const Options& options) const {
+        const time_t now = time(nullptr);
+        char date[64];
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+        char host[256] = {};
+        gethostname(host, sizeof(host) - 1);
+        static const char* const simd_levels[] = {"scalar", "sse2", "avx2"};
+
+        JsonRecord context;
+        context.Add("date"s, string(date))
+            .Add("host_name"s, string(host))
+            .Add("num_cpus"s, static_cast<double>(thread::hardware_concurrency()))
+            .Add("compiler"s, string(__VERSION__))
+#ifdef NDEBUG
+            .Add("library_build_type"s, "release"s)
+#else
+            .Add("library_build_type"s, "debug"s)
+#endif
+            .Add("simd_level"s, string(simd_levels[static_cast<int>(simd::DetectSimdLevel())]))
+            .Add("perf_counters"s, PerfCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES).IsAvailable()
+                                      ? "available"s
+                                      : "unavailable"s)
+#ifdef SIMPLE_VECTOR_DEBUG
+            .Add("checked_iterators"s, 1.0)
+#else
+            .Add("checked_iterators"s, 0.0)
+#endif
+            .Add("quick"s, options.quick ? 1.0 : 0.0);
+
+        out << "{\n  \"context\": "s << context.ToString() << ",\n  \"benchmarks\": [\n"s;
+        for (size_t i = 0; i < records_.size(); ++i) {
+            out << "    "s << records_[i].ToString() << (i + 1 == records_.size() ? "\n"s : ",\n"s);
+        }
+        out << "  ]\n}\n"s;
+    }
+
+private:
+    vector<JsonRecord> records_;
+};
+
+// Результат замера одной операции, усреднённый на одну операцию или один прогон
+struct Measurement {
+    double ns_per_op = 0;
+    double allocations = 0;
+    double bytes_allocated = 0;
+    double cache_misses = -1;
+    double l1d_misses = -1;
+};
+
+// Прогоняет run(state) repeats раз. setup() готовит состояние и в замер не входит,
+// как и разрушение состояния. Время — медиана прогонов, делённая на ops_per_run,
+// обращения к куче и промахи кэша — среднее на прогон
+template <typename Setup, typename Run>
+Measurement Measure(size_t repeats, size_t ops_per_run, Setup setup, Run run) {
+    PerfCounter cache_misses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    PerfCounter l1d_misses(PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                                          PERF_COUNT_HW_CACHE_RESULT_MISS));
+    vector<double> times;
+    size_t allocations = 0;
+    size_t bytes = 0;
+    long long cache_total = 0;
+    long long l1d_total = 0;
+    for (size_t i = 0; i < repeats; ++i) {
+        auto state = setup();
+        const size_t allocations_before = heap_allocations.load(memory_order_relaxed);
+        const size_t bytes_before = heap_bytes.load(memory_order_relaxed);
+        cache_misses.Start();
+        l1d_misses.Start();
+        const auto start = chrono::steady_clock::now();
+        run(state);
+        const auto finish = chrono::steady_clock::now();
+        const long long cache = cache_misses.Stop();
+        const long long l1d = l1d_misses.Stop();
+        allocations += heap_allocations.load(memory_order_relaxed) - allocations_before;
+        bytes += heap_bytes.load(memory_order_relaxed) - bytes_before;
+        cache_total = (cache < 0 || cache_total < 0) ? -1 : cache_total + cache;
+        l1d_total = (l1d < 0 || l1d_total < 0) ? -1 : l1d_total + l1d;
+        times.push_back(chrono::duration<double, nano>(finish - start).count());
+    }
+    nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+
+    Measurement result;
+    result.ns_per_op = times[times.size() / 2] / ops_per_run;
+    result.allocations = double(allocations) / repeats;
+    result.bytes_allocated = double(bytes) / repeats;
+    result.cache_misses = cache_total < 0 ? -1 : double(cache_total) / repeats;
+    result.l1d_misses = l1d_total < 0 ? -1 : double(l1d_total) / repeats;
+    return result;
+}
+
+// Единый интерфейс к SimpleVector и std::vector для сравнительных замеров
+template <typename Vector>
+struct VectorApi;
+
+template <typename Type>
+struct VectorApi<SimpleVector<Type>> {
+    static constexpr const char* NAME = "SimpleVector";
+    using Vector = SimpleVector<Type>;
+    using Value = Type;
+
+    static void PushBack(Vector& v, Type&& value) {
+        v.PushBack(move(value));
+    }
+    static void Insert(Vector& v, size_t index, Type&& value) {
+        v.Insert(v.begin() + index, move(value));
+    }
+    static void Erase(Vector& v, size_t index) {
+        v.Erase(v.begin() + index);
+    }
+    static void Reserve(Vector& v, size_t capacity) {
+        v.Reserve(capacity);
+    }
+    static void Resize(Vector& v, size_t size) {
+        v.Resize(size);
+    }
+    static size_t Size(const Vector& v) {
+        return v.GetSize();
+    }
+};
+
+template <typename Type>
+struct VectorApi<vector<Type>> {
+    static constexpr const char* NAME = "std::vector";
+    using Vector = vector<Type>;
+    using Value = Type;
+
+    static void PushBack(Vector& v, Type&& value) {
+        v.push_back(move(value));
+    }
+    static void Insert(Vector& v, size_t index, Type&& value) {
+        v.insert(v.begin() + index, move(value));
+    }
+    static void Erase(Vector& v, size_t index) {
+        v.erase(v.begin() + index);
+    }
+    static void Reserve(Vector& v, size_t capacity) {
+        v.reserve(capacity);
+    }
+    static void Resize(Vector& v, size_t size) {
+        v.resize(size);
+    }
+    static size_t Size(const Vector& v) {
+        return v.size();
+    }
+};
+
+// Значения элементов для замеров. Строки длиннее SSO-буфера, чтобы каждая жила в куче
+template <typename Type>
+Type MakeValue(size_t i);
+
+template <>
+int MakeValue<int>(size_t i) {
+    return static_cast<int>(i);
+}
+
+template <>
+string MakeValue<string>(size_t i) {
+    return "simple-vector-element-"s + to_string(i);
+}
+
+template <>
+X MakeValue<X>(size_t i) {
+    return X(i);
+}
+
+template <typename Vector>
+Vector MakeFilled(size_t size) {
+    using Api = VectorApi<Vector>;
+    using Type = typename Api::Value;
+    Vector v;
+    Api::Reserve(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        Api::PushBack(v, MakeValue<Type>(i));
+    }
+    return v;
+}
+
+struct OperationResult {
+    JsonRecord record;
+    double ns_per_op = 0;
+};
+
+// Замеры одного контейнера на одном типе элементов.
+// Возвращает результаты в порядке операций, чтобы сопоставить их со std::vector
+template <typename Vector>
+vector<OperationResult> RunVectorOperations(const string& type_name, const Options& options) {
+    using Api = VectorApi<Vector>;
+    using Type = typename Api::Value;
+    const size_t size = options.Scaled(1000000);
+    const size_t base_size = options.Scaled(100000);
+    const size_t middle_ops = max<size_t>(options.Scaled(200), 10);
+    const size_t move_ops = 1000;
+    const size_t repeats = 5;
+
+    vector<OperationResult> results;
+    auto record = [&](const string& operation, size_t n, const Measurement& m) {
+        JsonRecord r;
+        r.SetName("vector_ops/"s + operation + "/"s + Api::NAME + "<"s + type_name + ">/"s + to_string(n))
+            .Add("operation"s, operation)
+            .Add("container"s, string(Api::NAME))
+            .Add("type"s, type_name)
+            .Add("size"s, double(n))
+            .Add("repeats"s, double(repeats))
+            .Add("ns_per_op"s, m.ns_per_op)
+            .Add("allocations"s, m.allocations)
+            .Add("bytes_allocated"s, m.bytes_allocated)
+            .AddCounter("cache_misses"s, m.cache_misses)
+            .AddCounter("l1d_misses"s, m.l1d_misses);
+        results.push_back({r, m.ns_per_op});
+    };
+    auto empty = [] {
+        return Vector();
+    };
+    auto filled = [base_size] {
+        return MakeFilled<Vector>(base_size);
+    };
+
+    record("push_back"s, size, Measure(repeats, size, empty, [size](Vector& v) {
+        for (size_t i = 0; i < size; ++i) {
+            Api::PushBack(v, MakeValue<Type>(i));
+        }
+    }));
+    record("reserve_push_back"s, size, Measure(repeats, size, empty, [size](Vector& v) {
+        Api::Reserve(v, size);
+        for (size_t i = 0; i < size; ++i) {
+            Api::PushBack(v, MakeValue<Type>(i));
+        }
+    }));
+    record("resize"s, size, Measure(repeats, size, empty, [size](Vector& v) {
+        Api::Resize(v, size);
+    }));
+    record("insert_front"s, base_size, Measure(repeats, middle_ops, filled, [middle_ops](Vector& v) {
+        for (size_t i = 0; i < middle_ops; ++i) {
+            Api::Insert(v, 0, MakeValue<Type>(i));
+        }
+    }));
+    record("insert_middle"s, base_size, Measure(repeats, middle_ops, filled, [middle_ops](Vector& v) {
+        for (size_t i = 0; i < middle_ops; ++i) {
+            Api::Insert(v, Api::Size(v) / 2, MakeValue<Type>(i));
+        }
+    }));
+    record("insert_end"s, base_size, Measure(repeats, middle_ops, filled, [middle_ops](Vector& v) {
+        for (size_t i = 0; i < middle_ops; ++i) {
+            Api::Insert(v, Api::Size(v), MakeValue<Type>(i));
+        }
+    }));
+    record("erase_front"s, base_size, Measure(repeats, middle_ops, filled, [middle_ops](Vector& v) {
+        for (size_t i = 0; i < middle_ops; ++i) {
+            Api::Erase(v, 0);
+        }
+    }));
+    record("erase_middle"s, base_size, Measure(repeats, middle_ops, filled, [middle_ops](Vector& v) {
+        for (size_t i = 0; i < middle_ops; ++i) {
+            Api::Erase(v, Api::Size(v) / 2);
+        }
+    }));
+    if constexpr (is_copy_constructible_v<Type>) {
+        auto source = [size] {
+            return make_pair(MakeFilled<Vector>(size), Vector());
+        };
+        record("copy"s, size, Measure(repeats, 1, source, [](pair<Vector, Vector>& vectors) {
+            vectors.second = vectors.first;
+        }));
+    }
+    record("move"s, size, Measure(repeats, move_ops, [size] {
+        return MakeFilled<Vector>(size);
+    }, [move_ops](Vector& v) {
+        for (size_t i = 0; i < move_ops; ++i) {
+            Vector moved(move(v));
+            v = move(moved);
+        }
+    }));
+    return results;
+}
+
+// Сравнивает SimpleVector и std::vector на одном типе элементов.
+// К записи SimpleVector добавляется отношение времени std::vector к её времени
+template <typename Type>
+void BenchmarkVectorOperations(const string& type_name, JsonReporter& reporter, const Options& options) {
+    const vector<OperationResult> baseline = RunVectorOperations<vector<Type>>(type_name, options);
+    vector<OperationResult> simple = RunVectorOperations<SimpleVector<Type>>(type_name, options);
+    for (size_t i = 0; i < simple.size(); ++i) {
+        reporter.Report(baseline[i].record);
+        simple[i].record.Add("speedup_vs_std_vector"s, baseline[i].ns_per_op / simple[i].ns_per_op);
+        reporter.Report(simple[i].record);
+    }
+}
+
+// Печатает число конструирований, копирований и перемещений на одну вставку
+void BenchmarkAppendCounts(JsonReporter& reporter, const Options&) {
+    const size_t count = 1000;
+    auto report = [&](const string& name, auto append) {
+        SimpleVector<Tracked> v(Reserve(count));
+        Tracked::counters = TrackedCounters{};
+        for (size_t i = 0; i < count; ++i) {
+            append(v, static_cast<int>(i));
+        }
+        const auto& c = Tracked::counters;
+        JsonRecord r;
+        r.SetName("append_counts/"s + name)
+            .Add("constructions_per_op"s, double(c.constructions) / count)
+            .Add("copies_per_op"s, double(c.copies) / count)
+            .Add("moves_per_op"s, double(c.moves) / count);
+        reporter.Report(r);
+    };
+
+    report("PushBack(Tracked(i, 1))"s, [](auto& v, int i) {
+        v.PushBack(Tracked(i, 1));
+    });
+    report("EmplaceBack(i, 1)"s, [](auto& v, int i) {
+        v.EmplaceBack(i, 1);
+    });
+    report("Insert(end, Tracked(i, 1))"s, [](auto& v, int i) {
+        v.Insert(v.end(), Tracked(i, 1));
+    });
+    report("Emplace(end, i, 1)"s, [](auto& v, int i) {
+        v.Emplace(v.end(), i, 1);
+    });
+}
+
+// Сравнивает перенос через memcpy/memmove с поэлементным на int и IntNoRelocate
+void BenchmarkTriviallyRelocatable(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(2000000);
+    const size_t front_ops = 20;
+
+    auto measure = [](auto action) {
+        const auto start = chrono::steady_clock::now();
+        action();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+    auto run = [&](const string& name, auto make) {
+        using Value = decltype(make(0));
+        SimpleVector<Value> v;
+        const double growth = measure([&] {
+            for (size_t i = 0; i < size; ++i) {
+                v.PushBack(make(static_cast<int>(i)));
+            }
+        });
+        const double insert = measure([&] {
+            for (size_t i = 0; i < front_ops; ++i) {
+                v.Insert(v.begin(), make(0));
+            }
+        });
+        const double erase = measure([&] {
+            for (size_t i = 0; i < front_ops; ++i) {
+                v.Erase(v.begin());
+            }
+        });
+        JsonRecord r;
+        r.SetName("bulk_relocation/"s + name)
+            .Add("size"s, double(size))
+            .Add("growth_ms"s, growth)
+            .Add("insert_front_ms"s, insert)
+            .Add("erase_front_ms"s, erase);
+        if constexpr (is_copy_constructible_v<Value>) {
+            r.Add("copy_ms"s, measure([&] {
+                SimpleVector<Value> copy(v);
+            }));
+        }
+        reporter.Report(r);
+    };
+    run("int"s, [](int i) { return i; });
+    run("IntNoRelocate"s, [](int i) { return IntNoRelocate{i}; });
+    run("OwnedInt"s, [](int i) { return OwnedInt(i); });
+    run("unique_ptr<int>"s, [](int i) { return make_unique<int>(i); });
+}
+
+// Сравнивает число обращений к куче у SimpleVector и SmallSimpleVector на коротких векторах
+void BenchmarkSmallVectorAllocations(JsonReporter& reporter, const Options& options) {
+    const size_t vectors = options.Scaled(100000);
+
+    auto run = [&](const string& name, auto make_vector) {
+        CountingAllocator<int>::allocations = 0;
+        const auto start = chrono::steady_clock::now();
+        size_t checksum = 0;
+        for (size_t i = 0; i < vectors; ++i) {
+            auto v = make_vector();
+            const size_t size = i % 8 + 1;
+            for (size_t j = 0; j < size; ++j) {
+                v.PushBack(static_cast<int>(j));
+            }
+            checksum += v.GetSize();
+        }
+        const double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        JsonRecord r;
+        r.SetName("small_vector_allocations/"s + name)
+            .Add("vectors"s, double(vectors))
+            .Add("allocations"s, double(CountingAllocator<int>::allocations))
+            .Add("time_ms"s, ms)
+            .Add("checksum"s, double(checksum));
+        reporter.Report(r);
+    };
+    run("SimpleVector"s, [] {
+        return SimpleVector<int, CountingAllocator<int>>();
+    });
+    run("SmallSimpleVector<8>"s, [] {
+        return SmallSimpleVector<int, 8, CountingAllocator<int>>();
+    });
+    run("StaticVector<8>"s, [] {
+        return StaticVector<int, 8>();
+    });
+}
+
+// Пиковый RSS и промахи dTLB, измеренные в дочернем процессе
+struct ChildRunStats {
+    long peak_rss_kb = 0;
+    long long dtlb_misses = -1;  // -1, если счётчик perf_event недоступен
+    double ms = 0;
+};
+
+// Запускает action в дочернем процессе, чтобы пиковый RSS не смешивался между замерами
+template <typename Action>
+ChildRunStats RunInChild(Action action) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return {};
+    }
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        ChildRunStats stats;
+        PerfCounter dtlb_misses(PERF_TYPE_HW_CACHE, CacheEvent(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                                               PERF_COUNT_HW_CACHE_RESULT_MISS));
+        dtlb_misses.Start();
+        const auto start = chrono::steady_clock::now();
+        action();
+        stats.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        stats.dtlb_misses = dtlb_misses.Stop();
+        const ssize_t written = write(fds[1], &stats, sizeof(stats));
+        _exit(written == sizeof(stats) ? 0 : 1);
+    }
+    close(fds[1]);
+    ChildRunStats stats;
+    const ssize_t received = read(fds[0], &stats, sizeof(stats));
+    close(fds[0]);
+    int status = 0;
+    rusage usage{};
+    wait4(pid, &status, 0, &usage);
+    if (received != sizeof(stats)) {
+        return {};
+    }
+    stats.peak_rss_kb = usage.ru_maxrss;
+    return stats;
+}
+
+// Сравнивает рост SimpleVector<int> в обычной куче и в MmapAllocator
+void BenchmarkMmapStorage(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(50000000);
+
+    auto fill_and_scan = [size](auto& v) {
+        for (size_t i = 0; i < size; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        // Случайный доступ, чувствительный к промахам TLB
+        size_t index = 0;
+        long long sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            index = (index * 1103515245 + 12345) % size;
+            sum += v[index];
+        }
+        if (sum == -1) {
+            cout << sum;
+        }
+    };
+    auto report = [&](const string& name, const ChildRunStats& stats) {
+        JsonRecord r;
+        r.SetName("mmap_storage/"s + name)
+            .Add("size"s, double(size))
+            .Add("time_ms"s, stats.ms)
+            .Add("peak_rss_kib"s, double(stats.peak_rss_kb))
+            .AddCounter("dtlb_misses"s, double(stats.dtlb_misses));
+        reporter.Report(r);
+    };
+    report("std::allocator"s, RunInChild([&] {
+        SimpleVector<int> v;
+        fill_and_scan(v);
+    }));
+    report("MmapAllocator"s, RunInChild([&] {
+        SimpleVector<int, MmapAllocator<int>> v;
+        fill_and_scan(v);
+    }));
+}
+
+// Сравнивает WriteTo/ReadFrom с поэлементной записью и чтением через поток
+void BenchmarkVectorIo(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(64 * 1024 * 1024);  // 256 МиБ int
+    const string path = "/tmp/simple_vector_io_bench_"s + to_string(getpid());
+
+    const SimpleVector<int> v = GenerateVector(size);
+    const double gigabytes = double(size * sizeof(int)) / (1 << 30);
+    auto measure = [&](const string& name, auto action) {
+        const auto start = chrono::steady_clock::now();
+        action();
+        const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        JsonRecord r;
+        r.SetName("vector_io/"s + name)
+            .Add("bytes"s, double(size * sizeof(int)))
+            .Add("gib_per_second"s, gigabytes / seconds);
+        reporter.Report(r);
+    };
+
+    measure("ofstream_loop_write"s, [&] {
+        ofstream out(path, ios::binary);
+        for (int value : v) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    });
+    measure("ifstream_loop_read"s, [&] {
+        ifstream in(path, ios::binary);
+        SimpleVector<int> read;
+        int value = 0;
+        while (in.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+            read.PushBack(value);
+        }
+    });
+    measure("WriteTo"s, [&] {
+        const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        WriteTo(fd, v);
+        close(fd);
+    });
+    measure("ReadFrom"s, [&] {
+        const int fd = open(path.c_str(), O_RDONLY);
+        SimpleVector<int> read;
+        ReadFrom(fd, read);
+        close(fd);
+    });
+    remove(path.c_str());
+}
+
+// Сравнивает скалярные, SSE2 и AVX2 варианты алгоритмов на одном массиве
+template <typename T>
+void BenchmarkSimdType(const string& type_name, JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(10000000);
+    SimpleVector<T> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<T>(i % 97);
+    }
+    SimpleVector<T> copy(v);
+    const size_t repeats = 10;
+    static const char* const level_names[] = {"scalar", "sse2", "avx2"};
+
+    for (simd::SimdLevel level : {simd::SimdLevel::SCALAR, simd::SimdLevel::SSE2, simd::SimdLevel::AVX2}) {
+        simd::SetSimdLevel(level);
+        if (simd::GetSimdLevel() != level) {
+            continue;
+        }
+        double checksum = 0;
+        auto measure = [&](const string& operation, auto action) {
+            const Measurement m = Measure(repeats, size, [] {
+                return 0;
+            }, [&](int) {
+                checksum += static_cast<double>(action());
+            });
+            JsonRecord r;
+            r.SetName("simd/"s + operation + "/"s + type_name + "/"s + level_names[static_cast<int>(level)])
+                .Add("size"s, double(size))
+                .Add("ns_per_element"s, m.ns_per_op)
+                .AddCounter("cache_misses"s, m.cache_misses);
+            reporter.Report(r);
+        };
+        measure("equal"s, [&] { return v == copy; });
+        measure("find"s, [&] { return simd::Find(v, 200); });
+        measure("count"s, [&] { return simd::Count(v, 13); });
+        measure("sum"s, [&] { return simd::Sum(v); });
+        measure("minmax"s, [&] { return simd::MinMax(v).second; });
+        measure("fill"s, [&] {
+            simd::Fill(copy, 1);
+            return copy[size / 2];
+        });
+        copy = v;
+        if (checksum == -1) {
+            cerr << checksum;
+        }
+    }
+    simd::SetSimdLevel(simd::SimdLevel::AVX2);
+}
+
+// Пакетная вставка против поэлементной: Append и Insert(pos, first, last)
+// против цикла PushBack и Insert по одному элементу, std::vector — для сравнения
+void BenchmarkBatchInsert(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(1000000);
+    const size_t base_size = options.Scaled(100000);
+    const size_t batch = max<size_t>(options.Scaled(10000), 10);
+    const size_t repeats = 5;
+    vector<int> source(size);
+    for (size_t i = 0; i < size; ++i) {
+        source[i] = static_cast<int>(i);
+    }
+
+    auto report = [&](const string& name, size_t n, const Measurement& m) {
+        JsonRecord r;
+        r.SetName("batch_insert/"s + name)
+            .Add("elements"s, double(n))
+            .Add("ns_per_element"s, m.ns_per_op)
+            .Add("allocations"s, m.allocations);
+        reporter.Report(r);
+    };
+    auto empty = [] {
+        return SimpleVector<int>();
+    };
+    auto filled = [base_size] {
+        return SimpleVector<int>(base_size);
+    };
+
+    report("append/PushBack loop"s, size, Measure(repeats, size, empty, [&](SimpleVector<int>& v) {
+        for (int value : source) {
+            v.PushBack(value);
+        }
+    }));
+    report("append/Append"s, size, Measure(repeats, size, empty, [&](SimpleVector<int>& v) {
+        v.Append(source.begin(), source.end());
+    }));
+    report("append/std::vector::insert"s, size, Measure(repeats, size, [] {
+        return vector<int>();
+    }, [&](vector<int>& v) {
+        v.insert(v.end(), source.begin(), source.end());
+    }));
+    report("insert_middle/Insert loop"s, batch, Measure(repeats, batch, filled, [&](SimpleVector<int>& v) {
+        const size_t middle = v.GetSize() / 2;
+        for (size_t i = 0; i < batch; ++i) {
+            v.Insert(v.begin() + middle + i, source[i]);
+        }
+    }));
+    report("insert_middle/Insert range"s, batch, Measure(repeats, batch, filled, [&](SimpleVector<int>& v) {
+        v.Insert(v.begin() + v.GetSize() / 2, source.begin(), source.begin() + batch);
+    }));
+    report("insert_middle/std::vector::insert"s, batch, Measure(repeats, batch, [base_size] {
+        return vector<int>(base_size);
+    }, [&](vector<int>& v) {
+        v.insert(v.begin() + v.size() / 2, source.begin(), source.begin() + batch);
+    }));
+    report("erase_middle/Erase loop"s, batch, Measure(repeats, batch, filled, [&](SimpleVector<int>& v) {
+        const size_t middle = v.GetSize() / 2;
+        for (size_t i = 0; i < batch; ++i) {
+            v.Erase(v.begin() + middle);
+        }
+    }));
+    report("erase_middle/Erase range"s, batch, Measure(repeats, batch, filled, [&](SimpleVector<int>& v) {
+        const size_t middle = v.GetSize() / 2;
+        v.Erase(v.begin() + middle, v.begin() + middle + batch);
+    }));
+}
+
+// Цена инструментирования: PushBack без политики и с CountingInstrumentation.
+// Собранная статистика попадает в отчёт через CountingInstrumentation::ForEach
+void BenchmarkInstrumentation(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(10000000);
+    const size_t repeats = 5;
+
+    auto run = [&](const string& name, auto make_vector) {
+        const Measurement m = Measure(repeats, size, make_vector, [size](auto& v) {
+            for (size_t i = 0; i < size; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+        });
+        JsonRecord r;
+        r.SetName("instrumentation/push_back/"s + name)
+            .Add("size"s, double(size))
+            .Add("ns_per_op"s, m.ns_per_op);
+        reporter.Report(r);
+    };
+    run("NoInstrumentation"s, [] {
+        return SimpleVector<int>();
+    });
+    CountingInstrumentation::Reset();
+    run("CountingInstrumentation"s, [] {
+        return SimpleVector<int, allocator<int>, DoublingGrowth, CountingInstrumentation>();
+    });
+    CountingInstrumentation::ForEach([&reporter](const VectorStats& stats) {
+        JsonRecord r;
+        r.SetName("instrumentation/stats/"s + stats.type_name)
+            .Add("allocations"s, double(stats.allocations))
+            .Add("bytes_allocated"s, double(stats.bytes_allocated))
+            .Add("bytes_relocated"s, double(stats.bytes_relocated))
+            .Add("push_back_growths"s, double(stats.GetGrowthEvents(GrowthSource::PUSH_BACK)))
+            .Add("max_size"s, double(stats.max_size))
+            .Add("max_capacity"s, double(stats.max_capacity))
+            .Add("unused_bytes_at_release"s, double(stats.unused_bytes_at_release));
+        reporter.Report(r);
+    });
+}
+
+// Масштабирование параллельных алгоритмов: пулы от 1 потока до числа ядер.
+// Пул из одного потока выполняет всё в вызывающем и служит базой для speedup_vs_1_thread
+void BenchmarkParallel(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(16000000);
+    const size_t repeats = 5;
+    const size_t cores = max<size_t>(1, thread::hardware_concurrency());
+    vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < cores; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(cores);
+
+    SimpleVector<int> source(size);
+    for (size_t i = 0; i < size; ++i) {
+        source[i] = static_cast<int>((i * 2654435761u) % 1000003);
+    }
+    map<string, double> single_thread;
+    int64_t checksum = 0;
+
+    for (size_t threads : thread_counts) {
+        parallel::ThreadPool pool(threads);
+        auto report = [&](const string& operation, const Measurement& m) {
+            if (threads == 1) {
+                single_thread[operation] = m.ns_per_op;
+            }
+            JsonRecord r;
+            r.SetName("parallel/"s + operation + "/threads:"s + to_string(threads))
+                .Add("threads"s, double(threads))
+                .Add("size"s, double(size))
+                .Add("ns_per_element"s, m.ns_per_op)
+                .Add("speedup_vs_1_thread"s, single_thread[operation] / m.ns_per_op);
+            reporter.Report(r);
+        };
+        auto copy_source = [&source] {
+            return source;
+        };
+        report("fill"s, Measure(repeats, size, copy_source, [&](SimpleVector<int>& v) {
+            parallel::Fill(v, 1, pool);
+        }));
+        report("for_each"s, Measure(repeats, size, copy_source, [&](SimpleVector<int>& v) {
+            parallel::ForEach(v, [](int& x) {
+                x = x * 3 + 1;
+            }, pool);
+        }));
+        report("transform"s, Measure(repeats, size, [] {
+            return SimpleVector<double>();
+        }, [&](SimpleVector<double>& out) {
+            parallel::Transform(source, out, [](int x) {
+                return sqrt(static_cast<double>(x));
+            }, pool);
+        }));
+        report("reduce"s, Measure(repeats, size, [] {
+            return 0;
+        }, [&](int) {
+            checksum += parallel::Reduce(source, int64_t{0}, plus<>(), pool);
+        }));
+        report("sort"s, Measure(repeats, size, copy_source, [&](SimpleVector<int>& v) {
+            parallel::Sort(v, less<>(), pool);
+        }));
+        report("copy"s, Measure(repeats, size, [] {
+            return 0;
+        }, [&](int) {
+            checksum += parallel::Copy(source, pool).GetSize();
+        }));
+        report("resize_fill"s, Measure(repeats, size, [] {
+            return SimpleVector<int>();
+        }, [&](SimpleVector<int>& v) {
+            parallel::Resize(v, size, 7, pool);
+        }));
+    }
+    if (checksum == -1) {
+        cerr << checksum;
+    }
+}
+
+// Добавление из нескольких потоков: ConcurrentSimpleVector против SimpleVector под мьютексом
+void BenchmarkConcurrentAppend(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(4000000);
+    const size_t repeats = 5;
+    const size_t cores = max<size_t>(1, thread::hardware_concurrency());
+    vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < cores; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(cores);
+
+    for (size_t threads : thread_counts) {
+        auto run_writers = [threads, size](auto push) {
+            vector<thread> writers;
+            for (size_t t = 0; t < threads; ++t) {
+                writers.emplace_back([&push, t, threads, size] {
+                    for (size_t i = t; i < size; i += threads) {
+                        push(i);
+                    }
+                });
+            }
+            for (thread& writer : writers) {
+                writer.join();
+            }
+        };
+        auto report = [&](const string& name, const Measurement& m) {
+            JsonRecord r;
+            r.SetName("concurrent_append/"s + name + "/threads:"s + to_string(threads))
+                .Add("threads"s, double(threads))
+                .Add("size"s, double(size))
+                .Add("ns_per_element"s, m.ns_per_op)
+                .Add("allocations"s, m.allocations);
+            reporter.Report(r);
+        };
+        report("ConcurrentSimpleVector"s, Measure(repeats, size, [] {
+            return make_unique<ConcurrentSimpleVector<size_t>>();
+        }, [&](unique_ptr<ConcurrentSimpleVector<size_t>>& v) {
+            run_writers([&v](size_t i) {
+                v->PushBack(i);
+            });
+        }));
+        report("SimpleVector+mutex"s, Measure(repeats, size, [] {
+            return SimpleVector<size_t>();
+        }, [&](SimpleVector<size_t>& v) {
+            mutex m;
+            run_writers([&v, &m](size_t i) {
+                lock_guard<mutex> guard(m);
+                v.PushBack(i);
+            });
+        }));
+    }
+}
+
+// Чтение одного поля широких записей: массив структур (SimpleVector<Record>) против
+// столбца SoaVector — обычным циклом и через simd::Sum
+void BenchmarkSoaVector(JsonReporter& reporter, const Options& options) {
+    struct Record {
+        float price;
+        int32_t quantity;
+        int64_t id;
+        double weights[6];
+    };
+    const size_t size = options.Scaled(4000000);
+    const size_t repeats = 10;
+    SimpleVector<Record> records(Reserve(size));
+    SoaVector<float, int32_t, int64_t, array<double, 6>> columns;
+    columns.Reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        const float price = static_cast<float>(i % 100);
+        records.PushBack(Record{price, static_cast<int32_t>(i), static_cast<int64_t>(i), {}});
+        columns.EmplaceBack(price, static_cast<int32_t>(i), static_cast<int64_t>(i), array<double, 6>{});
+    }
+
+    double checksum = 0;
+    auto report = [&](const string& name, auto sum) {
+        const Measurement m = Measure(repeats, size, [] {
+            return 0;
+        }, [&](int) {
+            checksum += sum();
+        });
+        JsonRecord r;
+        r.SetName("soa/sum_price/"s + name)
+            .Add("size"s, double(size))
+            .Add("record_bytes"s, double(sizeof(Record)))
+            .Add("ns_per_element"s, m.ns_per_op)
+            .AddCounter("cache_misses"s, m.cache_misses);
+        reporter.Report(r);
+    };
+    report("SimpleVector<Record>"s, [&] {
+        float sum = 0;
+        for (const Record& record : records) {
+            sum += record.price;
+        }
+        return sum;
+    });
+    report("SoaVector column"s, [&] {
+        float sum = 0;
+        for (float price : columns.Column<float>()) {
+            sum += price;
+        }
+        return sum;
+    });
+    report("SoaVector column simd::Sum"s, [&] {
+        return simd::Sum(columns.Column<float>());
+    });
+    report("SoaVector proxy"s, [&] {
+        float sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += columns[i].Get<float>();
+        }
+        return sum;
+    });
+    if (checksum == -1) {
+        cerr << checksum;
+    }
+}
+
+// Раздача снимков таблицы: глубокая копия SimpleVector против O(1) копии CowSimpleVector.
+// snapshot_read — снимок и чтение нескольких элементов, snapshot_write — снимок и изменение
+// одного элемента (для CowSimpleVector это отцепление буфера)
+void BenchmarkCowSnapshots(JsonReporter& reporter, const Options& options) {
+    const size_t table_size = options.Scaled(100000);
+    const size_t snapshots = max<size_t>(options.Scaled(1000), 10);
+    const size_t repeats = 5;
+    SimpleVector<string> deep_table(Reserve(table_size));
+    for (size_t i = 0; i < table_size; ++i) {
+        deep_table.PushBack("route/"s + to_string(i));
+    }
+    const CowSimpleVector<string> cow_table{SimpleVector<string>(deep_table)};
+
+    size_t checksum = 0;
+    auto report = [&](const string& name, const Measurement& m) {
+        JsonRecord r;
+        r.SetName("cow/"s + name)
+            .Add("table_size"s, double(table_size))
+            .Add("ns_per_snapshot"s, m.ns_per_op)
+            .Add("allocations"s, m.allocations);
+        reporter.Report(r);
+    };
+    auto run = [&](const auto& table, bool write) {
+        return Measure(repeats, snapshots, [] {
+            return 0;
+        }, [&](int) {
+            for (size_t i = 0; i < snapshots; ++i) {
+                auto snapshot = table;
+                if (write) {
+                    snapshot[i % table_size] = "changed"s;
+                }
+                checksum += as_const(snapshot)[i % table_size].size();
+            }
+        });
+    };
+    report("snapshot_read/SimpleVector"s, run(deep_table, false));
+    report("snapshot_read/CowSimpleVector"s, run(cow_table, false));
+    report("snapshot_write/SimpleVector"s, run(deep_table, true));
+    report("snapshot_write/CowSimpleVector"s, run(cow_table, true));
+    if (checksum == 1) {
+        cerr << checksum;
+    }
+}
+
+// Задержка отдельных PushBack: у SimpleVector рост вдвое копирует все элементы и даёт
+// редкие долгие вызовы, у SegmentedVector рост — выделение одного куска.
+// Печатаются перцентили задержки вызова и время чтения по индексу
+void BenchmarkSegmentedAppend(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(8000000);
+    vector<float> latencies(size);
+
+    auto run = [&](const string& name, auto v) {
+        using Clock = chrono::steady_clock;
+        const auto start = Clock::now();
+        auto previous = start;
+        for (size_t i = 0; i < size; ++i) {
+            v.PushBack(static_cast<int>(i));
+            const auto now = Clock::now();
+            latencies[i] = static_cast<float>(chrono::duration<double, nano>(now - previous).count());
+            previous = now;
+        }
+        const double total_ns = chrono::duration<double, nano>(Clock::now() - start).count();
+
+        int64_t sum = 0;
+        const auto read_start = Clock::now();
+        for (size_t i = 0; i < size; ++i) {
+            sum += v[(i * 7919) % size];
+        }
+        const double read_ns = chrono::duration<double, nano>(Clock::now() - read_start).count() / size;
+        if (sum == -1) {
+            cerr << sum;
+        }
+
+        auto percentile = [&](double p) {
+            const size_t k = min(size - 1, static_cast<size_t>(p * size));
+            nth_element(latencies.begin(), latencies.begin() + k, latencies.end());
+            return double(latencies[k]);
+        };
+        JsonRecord r;
+        r.SetName("segmented_append/"s + name)
+            .Add("size"s, double(size))
+            .Add("ns_per_push_back"s, total_ns / size)
+            .Add("p50_ns"s, percentile(0.5))
+            .Add("p99_ns"s, percentile(0.99))
+            .Add("p999_ns"s, percentile(0.999))
+            .Add("max_ns"s, double(*max_element(latencies.begin(), latencies.end())))
+            .Add("random_read_ns"s, read_ns);
+        reporter.Report(r);
+    };
+    run("SimpleVector"s, SimpleVector<int>());
+    run("SegmentedVector"s, SegmentedVector<int>());
+}
+
+// Правки у курсора: серия вставок подряд, затем курсор сдвигается на несколько позиций,
+// как при наборе текста. И вставка в начало: Insert(begin()) у SimpleVector, PushFront у GapBuffer
+void BenchmarkGapBuffer(JsonReporter& reporter, const Options& options) {
+    const size_t base_size = options.Scaled(200000);
+    const size_t ops = max<size_t>(options.Scaled(20000), 64);
+    const size_t repeats = 5;
+
+    auto report = [&](const string& name, const Measurement& m) {
+        JsonRecord r;
+        r.SetName("gap_buffer/"s + name)
+            .Add("base_size"s, double(base_size))
+            .Add("ops"s, double(ops))
+            .Add("ns_per_op"s, m.ns_per_op)
+            .Add("allocations"s, m.allocations);
+        reporter.Report(r);
+    };
+    auto filled = [base_size](auto prototype) {
+        return [base_size, prototype] {
+            auto v = prototype;
+            v.Reserve(base_size);
+            for (size_t i = 0; i < base_size; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+            return v;
+        };
+    };
+    auto insert_at_cursor = [ops](auto& v) {
+        size_t cursor = v.GetSize() / 2;
+        for (size_t i = 0; i < ops; ++i) {
+            if (i % 64 == 63) {
+                cursor = cursor - 16 + (i * 7919) % 32;
+            }
+            v.Insert(v.begin() + cursor, static_cast<int>(i));
+            ++cursor;
+        }
+    };
+    report("insert_at_cursor/SimpleVector"s, Measure(repeats, ops, filled(SimpleVector<int>()), insert_at_cursor));
+    report("insert_at_cursor/GapBuffer"s, Measure(repeats, ops, filled(GapBuffer<int>()), insert_at_cursor));
+    report("insert_at_front/SimpleVector"s, Measure(repeats, ops, filled(SimpleVector<int>()), [ops](auto& v) {
+        for (size_t i = 0; i < ops; ++i) {
+            v.Insert(v.begin(), static_cast<int>(i));
+        }
+    }));
+    report("insert_at_front/GapBuffer"s, Measure(repeats, ops, filled(GapBuffer<int>()), [ops](auto& v) {
+        for (size_t i = 0; i < ops; ++i) {
+            v.PushFront(static_cast<int>(i));
+        }
+    }));
+}
+
+// Таблица квадратов вычетов по модулю: строится при старте или на этапе компиляции
+constexpr size_t LOOKUP_TABLE_SIZE = 4096;
+
+template <typename Table>
+constexpr void FillLookupTable(Table& table) {
+    for (size_t i = 0; i < LOOKUP_TABLE_SIZE; ++i) {
+        table.PushBack(static_cast<uint32_t>(i * i % 65521));
+    }
+}
+
+#ifdef SIMPLE_VECTOR_HAS_CONSTEXPR
+constexpr auto CONSTEXPR_LOOKUP_TABLE = [] {
+    StaticVector<uint32_t, LOOKUP_TABLE_SIZE> table;
+    FillLookupTable(table);
+    return table;
+}();
+#endif
+
+// Стоимость подготовки таблицы при старте и поиска по ней: SimpleVector заполняется
+// во время выполнения, constexpr StaticVector готов в .rodata
+void BenchmarkConstexprTable(JsonReporter& reporter, const Options& options) {
+    const size_t lookups = options.Scaled(10000000);
+    const size_t repeats = 5;
+    uint64_t checksum = 0;
+
+    auto report = [&](const string& name, const Measurement& startup, const Measurement& lookup) {
+        JsonRecord r;
+        r.SetName("constexpr_table/"s + name)
+            .Add("table_size"s, double(LOOKUP_TABLE_SIZE))
+            .Add("startup_ns"s, startup.ns_per_op)
+            .Add("startup_allocations"s, startup.allocations)
+            .Add("ns_per_lookup"s, lookup.ns_per_op);
+        reporter.Report(r);
+    };
+    auto lookup = [&](const auto& table) {
+        return Measure(repeats, lookups, [] {
+            return 0;
+        }, [&](int) {
+            uint32_t key = 1;
+            for (size_t i = 0; i < lookups; ++i) {
+                key = table[key % LOOKUP_TABLE_SIZE] + static_cast<uint32_t>(i);
+            }
+            checksum += key;
+        });
+    };
+
+    SimpleVector<uint32_t> runtime_table;
+    const Measurement runtime_startup = Measure(repeats, 1, [] {
+        return 0;
+    }, [&](int) {
+        SimpleVector<uint32_t> table;
+        FillLookupTable(table);
+        checksum += table[LOOKUP_TABLE_SIZE - 1];
+        runtime_table = std::move(table);
+    });
+    report("SimpleVector"s, runtime_startup, lookup(runtime_table));
+#ifdef SIMPLE_VECTOR_HAS_CONSTEXPR
+    const Measurement no_startup = Measure(repeats, 1, [] {
+        return 0;
+    }, [&](int) {
+        checksum += CONSTEXPR_LOOKUP_TABLE[LOOKUP_TABLE_SIZE - 1];
+    });
+    report("constexpr StaticVector"s, no_startup, lookup(CONSTEXPR_LOOKUP_TABLE));
+#endif
+    if (checksum == 1) {
+        cerr << checksum;
+    }
+}
+
+// Цена отладочного режима (SIMPLE_VECTOR_DEBUG): сумма и сортировка через указатель на данные,
+// итераторы SimpleVector и operator[]. В обычной сборке итераторы — указатели, проверок нет,
+// и relative_to_raw у всех вариантов должен быть около 1. Сборка с -DSIMPLE_VECTOR_DEBUG
+// (simple_vector_benchmark_debug) показывает, во что обходятся проверки
+void BenchmarkBoundsChecks(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(10000000);
+    const size_t sort_size = max<size_t>(options.Scaled(1000000), 1000);
+    const size_t repeats = 5;
+    int64_t checksum = 0;
+#ifdef SIMPLE_VECTOR_DEBUG
+    const double checked = 1;
+#else
+    const double checked = 0;
+#endif
+
+    SimpleVector<int> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<int>((i * 2654435761u) >> 8);
+    }
+
+    auto report = [&](const string& name, size_t n, const Measurement& m, const Measurement& raw) {
+        JsonRecord r;
+        r.SetName("bounds_checks/"s + name)
+            .Add("size"s, double(n))
+            .Add("checked"s, checked)
+            .Add("ns_per_element"s, m.ns_per_op)
+            .Add("relative_to_raw"s, m.ns_per_op / raw.ns_per_op);
+        reporter.Report(r);
+    };
+    auto measure_sum = [&](auto sum) {
+        return Measure(repeats, size, [] {
+            return 0;
+        }, [&](int) {
+            checksum += sum();
+        });
+    };
+
+    const Measurement sum_raw = measure_sum([&] {
+        const int* data = v.GetData();
+        int64_t sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += data[i];
+        }
+        return sum;
+    });
+    const Measurement sum_iterator = measure_sum([&] {
+        int64_t sum = 0;
+        for (const int item : v) {
+            sum += item;
+        }
+        return sum;
+    });
+    const Measurement sum_index = measure_sum([&] {
+        int64_t sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += v[i];
+        }
+        return sum;
+    });
+    report("sum/raw_pointer"s, size, sum_raw, sum_raw);
+    report("sum/iterator"s, size, sum_iterator, sum_raw);
+    report("sum/operator[]"s, size, sum_index, sum_raw);
+
+    auto measure_sort = [&](auto sort) {
+        return Measure(repeats, sort_size, [&] {
+            SimpleVector<int> items;
+            items.Append(v.begin(), v.begin() + sort_size);
+            return items;
+        }, [&](SimpleVector<int>& items) {
+            sort(items);
+            checksum += items[sort_size / 2];
+        });
+    };
+    const Measurement sort_raw = measure_sort([](SimpleVector<int>& items) {
+        std::sort(items.GetData(), items.GetData() + items.GetSize());
+    });
+    const Measurement sort_iterator = measure_sort([](SimpleVector<int>& items) {
+        std::sort(items.begin(), items.end());
+    });
+    report("sort/raw_pointer"s, sort_size, sort_raw, sort_raw);
+    report("sort/iterator"s, sort_size, sort_iterator, sort_raw);
+    if (checksum == 1) {
+        cerr << checksum;
+    }
+}
+
+// Память и скорость PackedVector против SimpleVector на последовательных идентификаторах (iota)
+// и на маленьких случайных числах: байты на элемент, случайный доступ, обход и распаковка блоками
+void BenchmarkPackedVector(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(16000000);
+    const size_t lookups = options.Scaled(4000000);
+    const size_t repeats = 5;
+    int64_t checksum = 0;
+
+    auto run = [&](const string& data_name, const SimpleVector<int>& source) {
+        PackedVector<int> packed(source.begin(), source.end());
+        packed.ShrinkToFit();
+        SimpleVector<int> plain(source);
+        plain.ShrinkToFit();
+
+        auto report = [&](const string& name, double bytes, const Measurement& random,
+                          const Measurement& scan, const Measurement& unpack) {
+            JsonRecord r;
+            r.SetName("packed_vector/"s + data_name + "/"s + name)
+                .Add("size"s, double(size))
+                .Add("bytes_per_element"s, bytes / double(size))
+                .Add("ns_per_random_access"s, random.ns_per_op)
+                .Add("ns_per_element_scan"s, scan.ns_per_op)
+                .Add("ns_per_element_unpack"s, unpack.ns_per_op);
+            reporter.Report(r);
+        };
+        auto random_access = [&](const auto& v) {
+            return Measure(repeats, lookups, [] {
+                return 0;
+            }, [&](int) {
+                uint64_t state = 42;
+                int64_t sum = 0;
+                for (size_t i = 0; i < lookups; ++i) {
+                    state = state * 6364136223846793005ull + 1442695040888963407ull;
+                    sum += v[(state >> 20) % size];
+                }
+                checksum += sum;
+            });
+        };
+        SimpleVector<int> buffer(size);
+
+        const Measurement plain_scan = Measure(repeats, size, [] {
+            return 0;
+        }, [&](int) {
+            int64_t sum = 0;
+            for (const int value : plain) {
+                sum += value;
+            }
+            checksum += sum;
+        });
+        const Measurement plain_copy = Measure(repeats, size, [] {
+            return 0;
+        }, [&](int) {
+            std::copy(plain.begin(), plain.end(), buffer.begin());
+            checksum += buffer[size / 2];
+        });
+        report("SimpleVector"s, double(plain.GetCapacity() * sizeof(int)), random_access(plain), plain_scan, plain_copy);
+
+        for (simd::SimdLevel level : {simd::SimdLevel::SCALAR, simd::SimdLevel::AVX2}) {
+            simd::SetSimdLevel(level);
+            if (simd::GetSimdLevel() != level) {
+                continue;
+            }
+            const Measurement scan = Measure(repeats, size, [] {
+                return 0;
+            }, [&](int) {
+                int64_t sum = 0;
+                packed.ForEach([&sum](int value) {
+                    sum += value;
+                });
+                checksum += sum;
+            });
+            const Measurement unpack = Measure(repeats, size, [] {
+                return 0;
+            }, [&](int) {
+                packed.Unpack(0, size, buffer.GetData());
+                checksum += buffer[size / 2];
+            });
+            report("PackedVector/"s + (level == simd::SimdLevel::AVX2 ? "avx2"s : "scalar"s),
+                   double(packed.GetAllocatedBytes()), random_access(packed), scan, unpack);
+        }
+        simd::SetSimdLevel(simd::DetectSimdLevel());
+    };
+
+    run("iota"s, GenerateVector(size));
+    SimpleVector<int> small(size);
+    uint64_t state = 7;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        small[i] = static_cast<int>((state >> 33) % 1000);
+    }
+    run("small_random"s, small);
+    if (checksum == 1) {
+        cerr << checksum;
+    }
+}
+
+// Ленивый конвейер против циклов, которые пишутся сейчас: Filter + Map с промежуточным вектором
+// и одним циклом с PushBack, ранняя остановка Take, пачки Batch.
+// Предвыборка: обход вектора указателей на перемешанные узлы таблицы больше кэша
+void BenchmarkPipeline(JsonReporter& reporter, const Options& options) {
+    const size_t size = options.Scaled(16000000);
+    const size_t repeats = 5;
+    int64_t checksum = 0;
+
+    auto report = [&](const string& name, size_t n, const Measurement& m) {
+        JsonRecord r;
+        r.SetName("pipeline/"s + name)
+            .Add("size"s, double(n))
+            .Add("ns_per_element"s, m.ns_per_op)
+            .Add("allocations"s, m.allocations)
+            .Add("bytes_allocated"s, m.bytes_allocated)
+            .AddCounter("cache_misses"s, m.cache_misses);
+        reporter.Report(r);
+    };
+
+    SimpleVector<int> source(size);
+    uint64_t state = 11;
+    for (size_t i = 0; i < size; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        source[i] = static_cast<int>(state >> 40);
+    }
+    auto keep = [](int x) {
+        return x % 4 == 0;
+    };
+    auto transform = [](int x) {
+        return static_cast<int64_t>(x) * 3 + 1;
+    };
+    auto empty = [] {
+        return SimpleVector<int64_t>();
+    };
+    auto consume = [&](const SimpleVector<int64_t>& out) {
+        checksum += static_cast<int64_t>(out.GetSize()) + (out.IsEmpty() ? 0 : out[out.GetSize() / 2]);
+    };
+
+    report("filter_map/eager_intermediate"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        SimpleVector<int> filtered;
+        for (const int x : source) {
+            if (keep(x)) {
+                filtered.PushBack(x);
+            }
+        }
+        out.Reserve(filtered.GetSize());
+        for (const int x : filtered) {
+            out.PushBack(transform(x));
+        }
+        consume(out);
+    }));
+    report("filter_map/eager_loop"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        for (const int x : source) {
+            if (keep(x)) {
+                out.PushBack(transform(x));
+            }
+        }
+        consume(out);
+    }));
+    report("filter_map/pipeline"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        MakePipeline(source).Filter(keep).Map(transform).CollectInto(out);
+        consume(out);
+    }));
+    report("map/eager_loop"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        for (const int x : source) {
+            out.PushBack(transform(x));
+        }
+        consume(out);
+    }));
+    report("map/pipeline"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        MakePipeline(source).Map(transform).CollectInto(out);
+        consume(out);
+    }));
+
+    // Первые take отобранных: eager отбирает всё и обрезает, конвейер останавливает обход
+    const size_t take = 1000;
+    report("take/eager_intermediate"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        SimpleVector<int64_t> all;
+        for (const int x : source) {
+            if (keep(x)) {
+                all.PushBack(transform(x));
+            }
+        }
+        out.Append(all.begin(), all.begin() + min(take, all.GetSize()));
+        consume(out);
+    }));
+    report("take/pipeline"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        MakePipeline(source).Filter(keep).Map(transform).Take(take).CollectInto(out);
+        consume(out);
+    }));
+
+    // Суммы пачек по batch элементов: eager сначала раскладывает всё по векторам пачек
+    const size_t batch = 256;
+    report("batch/eager_intermediate"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        SimpleVector<SimpleVector<int>> batches;
+        for (size_t i = 0; i < size; i += batch) {
+            batches.EmplaceBack().Append(source.begin() + i, source.begin() + min(i + batch, size));
+        }
+        for (const SimpleVector<int>& b : batches) {
+            out.PushBack(accumulate(b.begin(), b.end(), int64_t{0}));
+        }
+        consume(out);
+    }));
+    report("batch/pipeline"s, size, Measure(repeats, size, empty, [&](SimpleVector<int64_t>& out) {
+        MakePipeline(source)
+            .Batch(batch)
+            .Map([](const SimpleVector<int>& b) {
+                return accumulate(b.begin(), b.end(), int64_t{0});
+            })
+            .CollectInto(out);
+        consume(out);
+    }));
+
+    // Узел в отдельной строке кэша, порядок обхода случайный: аппаратная предвыборка не помогает.
+    // Обработка узла с непредсказуемыми ветвлениями: ошибки предсказания сбрасывают внеочередное
+    // исполнение, и без программной предвыборки промахи обслуживаются почти по одному
+    struct alignas(64) Node {
+        int64_t value = 0;
+    };
+    const size_t nodes_count = options.Scaled(4000000);
+    SimpleVector<Node> nodes(nodes_count);
+    SimpleVector<const Node*> pointers(nodes_count);
+    state = 5;
+    for (size_t i = 0; i < nodes_count; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        nodes[i].value = static_cast<int64_t>(state >> 33);
+        pointers[i] = &nodes[i];
+    }
+    for (size_t i = nodes_count; i > 1; --i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        swap(pointers[i - 1], pointers[(state >> 33) % i]);
+    }
+    auto process = [](int64_t& sum, const Node* node) {
+        const int64_t value = node->value;
+        if (value % 3 == 0) {
+            sum += value / 7;
+        } else if (value % 5 == 1) {
+            sum -= value;
+        }
+    };
+    auto zero = [] {
+        return 0;
+    };
+    report("prefetch/none"s, nodes_count, Measure(repeats, nodes_count, zero, [&](int) {
+        int64_t sum = 0;
+        for (const Node* node : pointers) {
+            process(sum, node);
+        }
+        checksum += sum;
+    }));
+    for (size_t distance : {4, 16, 32, 64}) {
+        report("prefetch/distance_"s + to_string(distance), nodes_count, Measure(repeats, nodes_count, zero, [&](int) {
+            int64_t sum = 0;
+            for (const Node* node : Prefetched(pointers, distance)) {
+                process(sum, node);
+            }
+            checksum += sum;
+        }));
+    }
+    report("prefetch/pipeline_distance_32"s, nodes_count, Measure(repeats, nodes_count, zero, [&](int) {
+        int64_t sum = 0;
+        MakePipeline(Prefetched(pointers, 32)).ForEach([&](const Node* node) {
+            process(sum, node);
+        });
+        checksum += sum;
+    }));
+    if (checksum == 1) {
+        cerr << checksum;
+    }
+}
+
+// Поиск, обход и построение словаря int -> int: FlatMap против std::map и std::unordered_map
+// на таблице, помещающейся в L1/L2, и на таблице больше кэша
+void BenchmarkFlatMap(JsonReporter& reporter, const Options& options) {
+    const size_t lookups = options.Scaled(2000000);
+    const size_t repeats = 5;
+    uint64_t checksum = 0;
+
+    for (const size_t size : {size_t{1000}, max<size_t>(options.Scaled(200000), 1000)}) {
+        // Ключи — перемешанные чётные числа, запросы попадают в половину случаев
+        vector<pair<int, int>> items(size);
+        for (size_t i = 0; i < size; ++i) {
+            const int key = static_cast<int>((i * 2654435761u) % (size * 2)) & ~1;
+            items[i] = {key, static_cast<int>(i)};
+        }
+        vector<int> queries(lookups);
+        for (size_t i = 0; i < lookups; ++i) {
+            queries[i] = static_cast<int>((i * 40503u + 17) % (size * 2));
+        }
+
+        auto report = [&](const string& name, const Measurement& build, const Measurement& find,
+                          const Measurement& iterate) {
+            JsonRecord r;
+            r.SetName("flat_map/"s + name + "/"s + to_string(size))
+                .Add("size"s, double(size))
+                .Add("build_ns_per_item"s, build.ns_per_op)
+                .Add("build_allocations"s, build.allocations)
+                .Add("find_ns"s, find.ns_per_op)
+                .Add("iterate_ns_per_item"s, iterate.ns_per_op);
+            reporter.Report(r);
+        };
+        auto run = [&](const string& name, auto build) {
+            const Measurement build_time = Measure(repeats, size, [] {
+                return 0;
+            }, [&](int) {
+                checksum += build().size();
+            });
+            const auto map = build();
+            const Measurement find_time = Measure(repeats, lookups, [] {
+                return 0;
+            }, [&](int) {
+                for (const int query : queries) {
+                    const auto it = map.find(query);
+                    checksum += it != map.end() ? static_cast<uint64_t>(it->second) : 0;
+                }
+            });
+            const Measurement iterate_time = Measure(repeats, size, [] {
+                return 0;
+            }, [&](int) {
+                for (const auto& [key, value] : map) {
+                    checksum += static_cast<uint64_t>(key + value);
+                }
+            });
+            report(name, build_time, find_time, iterate_time);
+        };
+
+        // Обёртка даёт FlatMap интерфейс find/size стандартных словарей
+        struct FlatMapAdapter {
+            FlatMap<int, int> map;
+
+            auto find(int key) const {
+                return map.Find(key);
+            }
+            auto end() const {
+                return map.end();
+            }
+            auto begin() const {
+                return map.begin();
+            }
+            size_t size() const {
+                return map.GetSize();
+            }
+        };
+        run("FlatMap"s, [&] {
+            return FlatMapAdapter{FlatMap<int, int>(items.begin(), items.end())};
+        });
+        run("std::map"s, [&] {
+            return map<int, int>(items.begin(), items.end());
+        });
+        run("std::unordered_map"s, [&] {
+            return unordered_map<int, int>(items.begin(), items.end());
+        });
+    }
+    if (checksum == 1) {
+        cerr << checksum;
+    }
+}
+
+struct BenchmarkGroup {
+    string name;
+    function<void(JsonReporter&, const Options&)> run;
+};
+
+const vector<BenchmarkGroup>& GetBenchmarkGroups() {
+    static const vector<BenchmarkGroup> groups = {
+        {"vector_ops/int"s, [](JsonReporter& reporter, const Options& options) {
+             BenchmarkVectorOperations<int>("int"s, reporter, options);
+         }},
+        {"vector_ops/string"s, [](JsonReporter& reporter, const Options& options) {
+             BenchmarkVectorOperations<string>("std::string"s, reporter, options);
+         }},
+        {"vector_ops/X"s, [](JsonReporter& reporter, const Options& options) {
+             BenchmarkVectorOperations<X>("X"s, reporter, options);
+         }},
+        {"append_counts"s, BenchmarkAppendCounts},
+        {"instrumentation"s, BenchmarkInstrumentation},
+        {"batch_insert"s, BenchmarkBatchInsert},
+        {"bulk_relocation"s, BenchmarkTriviallyRelocatable},
+        {"small_vector_allocations"s, BenchmarkSmallVectorAllocations},
+        {"mmap_storage"s, BenchmarkMmapStorage},
+        {"vector_io"s, BenchmarkVectorIo},
+        {"parallel"s, BenchmarkParallel},
+        {"concurrent_append"s, BenchmarkConcurrentAppend},
+        {"soa"s, BenchmarkSoaVector},
+        {"cow"s, BenchmarkCowSnapshots},
+        {"segmented_append"s, BenchmarkSegmentedAppend},
+        {"gap_buffer"s, BenchmarkGapBuffer},
+        {"constexpr_table"s, BenchmarkConstexprTable},
+        {"flat_map"s, BenchmarkFlatMap},
+        {"bounds_checks"s, BenchmarkBoundsChecks},
+        {"packed_vector"s, BenchmarkPackedVector},
+        {"pipeline"s, BenchmarkPipeline},
+        {"simd"s, [](JsonReporter& reporter, const Options& options) {
+             BenchmarkSimdType<int32_t>("int32_t"s, reporter, options);
+             BenchmarkSimdType<uint8_t>("uint8_t"s, reporter, options);
+             BenchmarkSimdType<float>("float"s, reporter, options);
+             BenchmarkSimdType<double>("double"s, reporter, options);
+         }},
+    };
+    return groups;
+}
+
+void PrintUsage() {
+    cerr << "Usage: simple_vector_benchmark [--benchmark_filter=<substring>] [--benchmark_out=<file>] [--quick]\n"s
+         << "Groups:"s;
+    for (const BenchmarkGroup& group : GetBenchmarkGroups()) {
+        cerr << ' ' << group.name;
+    }
+    cerr << endl;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg.rfind("--benchmark_filter="s, 0) == 0) {
+            options.filter = arg.substr(arg.find('=') + 1);
+        } else if (arg.rfind("--benchmark_out="s, 0) == 0) {
+            options.out_path = arg.substr(arg.find('=') + 1);
+        } else if (arg == "--quick"s) {
+            options.quick = true;
+        } else {
+            PrintUsage();
+            return arg == "--help"s ? 0 : 1;
+        }
+    }
+
+    JsonReporter reporter;
+    for (const BenchmarkGroup& group : GetBenchmarkGroups()) {
+        if (group.name.find(options.filter) == string::npos) {
+            continue;
+        }
+        cerr << group.name << endl;
+        group.run(reporter, options);
+    }
+
+    if (options.out_path.empty()) {
+        reporter.Write(cout, options);
+    } else {
+        ofstream out(options.out_path);
+        reporter.Write(out, options);
+        if (!out) {
+            cerr << "Cannot write "s << options.out_path << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
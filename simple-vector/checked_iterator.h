@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+// Отладочный режим включается макросом SIMPLE_VECTOR_DEBUG (например, -DSIMPLE_VECTOR_DEBUG),
+// независимо от NDEBUG. В нём ArrayPtr и SimpleVector проверяют индексы в operator[],
+// а итераторы SimpleVector становятся CheckedIterator и ловят обращение через итератор,
+// полученный до Reserve, Resize, Insert, Erase и других изменений вектора.
+// Нарушение печатает сообщение и вызывает std::abort().
+// Ограничение режима: итератор привязан к объекту вектора, а не к его буферу, поэтому
+// после swap и перемещения вектора прежние итераторы считаются недействительными,
+// хотя стандарт оставляет их действительными (они указывают в другой вектор).
+// Код, который пользуется итераторами после swap или перемещения, в этом режиме падает —
+// получите итераторы заново у вектора, который теперь владеет элементами.
+// Без макроса проверок нет вовсе: итераторы — обычные указатели, и код совпадает с кодом без этого режима
+#ifdef SIMPLE_VECTOR_DEBUG
+#define SIMPLE_VECTOR_CHECK(condition, message) \
+    ((condition) ? static_cast<void>(0) : SimpleVectorCheckFailed(message, __FILE__, __LINE__))
+#else
+#define SIMPLE_VECTOR_CHECK(condition, message) static_cast<void>(0)
+#endif
+
+[[noreturn]] inline void SimpleVectorCheckFailed(const char* message, const char* file, int line) noexcept {
+    std::fprintf(stderr, "%s:%d: SimpleVector check failed: %s\n", file, line, message);
+    std::abort();
+}
+
+// Итератор отладочного режима: указатель на элемент, контейнер и номер поколения контейнера
+// на момент получения итератора. Контейнер увеличивает поколение при каждом изменении,
+// после которого итераторы недействительны. Разыменование проверяет поколение и границы.
+// Container должен предоставлять GetData(), GetSize() и GetGeneration().
+// Value — тип элемента или const Value
+template <typename Container, typename Value>
+class CheckedIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    constexpr CheckedIterator() noexcept = default;
+
+    constexpr CheckedIterator(Value* ptr, const Container* owner, size_t generation) noexcept
+    : ptr_(ptr), owner_(owner), generation_(generation) {
+    }
+
+    // Итератор на изменяемые элементы приводится к итератору на константные
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value> &&
+                                                          !std::is_same_v<Other, Value>>>
+    constexpr CheckedIterator(const CheckedIterator<Container, Other>& other) noexcept
+    : ptr_(other.ptr_), owner_(other.owner_), generation_(other.generation_) {
+    }
+
+    // Указатель, проверенный на действительность: внутри [begin, end] своего контейнера
+    constexpr Value* Base() const noexcept {
+        CheckValid();
+        SIMPLE_VECTOR_CHECK(ptr_ >= Begin() && ptr_ <= Begin() + owner_->GetSize(), "iterator is out of range");
+        return ptr_;
+    }
+
+    constexpr const Container* GetOwner() const noexcept {
+        return owner_;
+    }
+
+    constexpr reference operator*() const noexcept {
+        CheckDereferenceable(ptr_);
+        return *ptr_;
+    }
+
+    constexpr pointer operator->() const noexcept {
+        CheckDereferenceable(ptr_);
+        return ptr_;
+    }
+
+    constexpr reference operator[](difference_type n) const noexcept {
+        CheckDereferenceable(ptr_ + n);
+        return ptr_[n];
+    }
+
+    constexpr CheckedIterator& operator++() noexcept {
+        ++ptr_;
+        return *this;
+    }
+
+    constexpr CheckedIterator operator++(int) noexcept {
+        CheckedIterator old = *this;
+        ++ptr_;
+        return old;
+    }
+
+    constexpr CheckedIterator& operator--() noexcept {
+        --ptr_;
+        return *this;
+    }
+
+    constexpr CheckedIterator operator--(int) noexcept {
+        CheckedIterator old = *this;
+        --ptr_;
+        return old;
+    }
+
+    constexpr CheckedIterator& operator+=(difference_type n) noexcept {
+        ptr_ += n;
+        return *this;
+    }
+
+    constexpr CheckedIterator& operator-=(difference_type n) noexcept {
+        ptr_ -= n;
+        return *this;
+    }
+
+    friend constexpr CheckedIterator operator+(CheckedIterator it, difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend constexpr CheckedIterator operator+(difference_type n, CheckedIterator it) noexcept {
+        return it += n;
+    }
+
+    friend constexpr CheckedIterator operator-(CheckedIterator it, difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend constexpr difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        CheckComparable(lhs, rhs);
+        return lhs.ptr_ - rhs.ptr_;
+    }
+
+    friend constexpr bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        CheckComparable(lhs, rhs);
+        return lhs.ptr_ == rhs.ptr_;
+    }
+
+    friend constexpr bool operator!=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        CheckComparable(lhs, rhs);
+        return lhs.ptr_ < rhs.ptr_;
+    }
+
+    friend constexpr bool operator>(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    template <typename, typename>
+    friend class CheckedIterator;
+
+    constexpr const value_type* Begin() const noexcept {
+        return owner_->GetData();
+    }
+
+    constexpr void CheckValid() const noexcept {
+        SIMPLE_VECTOR_CHECK(owner_ != nullptr, "iterator is not bound to a vector");
+        SIMPLE_VECTOR_CHECK(owner_->GetGeneration() == generation_,
+                            "iterator is used after the vector was modified (Reserve, Resize, Insert, Erase...)");
+    }
+
+    constexpr void CheckDereferenceable(const Value* ptr) const noexcept {
+        CheckValid();
+        SIMPLE_VECTOR_CHECK(ptr >= Begin() && ptr < Begin() + owner_->GetSize(), "iterator is not dereferenceable");
+    }
+
+    static constexpr void CheckComparable(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        // Итераторы, созданные по умолчанию, можно сравнивать между собой, как у стандартных
+        if (lhs.owner_ == nullptr && rhs.owner_ == nullptr) {
+            return;
+        }
+        lhs.CheckValid();
+        rhs.CheckValid();
+        SIMPLE_VECTOR_CHECK(lhs.owner_ == rhs.owner_, "iterators of different vectors are compared");
+    }
+
+    Value* ptr_ = nullptr;
+    const Container* owner_ = nullptr;
+    size_t generation_ = 0;
+};
+
+// Указатель на элемент, на который указывает итератор. Для указателей — сам указатель,
+// для CheckedIterator — проверенный указатель. Нужен коду, которому нужна память
+// SimpleVector напрямую (SIMD, ввод-вывод, двоичный поиск): в обычной сборке вызов исчезает
+template <typename T>
+constexpr T* UnwrapIterator(T* it) noexcept {
+    return it;
+}
+
+template <typename Container, typename Value>
+constexpr Value* UnwrapIterator(const CheckedIterator<Container, Value>& it) noexcept {
+    return it.Base();
+}
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Вектор для одновременного добавления из многих потоков.
+// Элементы хранятся в корзинах: корзина b вмещает FIRST_BUCKET_SIZE << b элементов и никогда
+// не переносится, поэтому адреса элементов стабильны, а читатели могут обходить вектор,
+// пока в него пишут. PushBack/EmplaceBack без блокировок: сначала ставится корзина для
+// следующего индекса (одной попыткой compare_exchange, проигравший поток возвращает свою память),
+// затем индекс занимается compare_exchange, а готовность элемента публикуется флагом в его ячейке.
+// Индекс занимается только при готовой корзине: если корзину не удалось выделить, PushBack
+// бросает std::bad_alloc, не заняв индекса, и следующий PushBack снова пробует выделить корзину.
+// Поэтому каждый занятый индекс рано или поздно становится готовым элементом.
+// Элемент создаётся в ячейке только без исключений: если Type не создаётся из аргументов
+// с noexcept, он сначала создаётся во временном объекте, а затем перемещается в ячейку.
+// Allocator должен допускать одновременные вызовы из разных потоков (как std::allocator).
+// Удаление элементов, Clear и разрушение вектора одновременно с записью не допускаются
+template <typename Type, typename Allocator = std::allocator<Type>>
+class ConcurrentSimpleVector {
+    static_assert(std::is_nothrow_move_constructible_v<Type>,
+                  "ConcurrentSimpleVector publishes elements by a non-throwing move");
+
+    struct Slot {
+        alignas(Type) unsigned char storage[sizeof(Type)];
+        std::atomic<bool> ready{false};
+
+        Type* Get() noexcept {
+            return std::launder(reinterpret_cast<Type*>(storage));
+        }
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    template <typename Value>
+    class BasicIterator;
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+    using AllocatorType = Allocator;
+
+    static constexpr size_t FIRST_BUCKET_SIZE = 8;
+
+    ConcurrentSimpleVector() noexcept = default;
+
+    explicit ConcurrentSimpleVector(const Allocator& alloc) noexcept
+    : alloc_(alloc) {
+    }
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        Clear();
+        for (size_t b = 0; b < BUCKET_COUNT; ++b) {
+            Slot* bucket = buckets_[b].load(std::memory_order_relaxed);
+            if (bucket != nullptr) {
+                FreeBucket(bucket, BucketSize(b));
+            }
+        }
+    }
+
+    Allocator GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Число занятых индексов. Элементы с индексами, занятыми только что,
+    // могут быть ещё не готовы (см. IsReady)
+    size_t GetSize() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Суммарная вместимость выделенных корзин
+    size_t GetCapacity() const noexcept {
+        size_t capacity = 0;
+        for (size_t b = 0; b < BUCKET_COUNT; ++b) {
+            Slot* bucket = buckets_[b].load(std::memory_order_acquire);
+            if (bucket != nullptr) {
+                capacity += BucketSize(b);
+            }
+        }
+        return capacity;
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Создан ли элемент с индексом index и виден ли он текущему потоку
+    bool IsReady(size_t index) const noexcept {
+        const Slot* slot = FindSlot(index);
+        return slot != nullptr && slot->ready.load(std::memory_order_acquire);
+    }
+
+    // Доступ без проверок: элемент index должен быть готов (IsReady)
+    Type& operator[](size_t index) noexcept {
+        return *FindSlot(index)->Get();
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return *FindSlot(index)->Get();
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size или элемент ещё не готов
+    Type& At(size_t index) {
+        if (index >= GetSize() || !IsReady(index)) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize() || !IsReady(index)) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    // Дожидается готовности элемента index, занятого другим потоком
+    const Type& Wait(size_t index) const {
+        const auto [b, offset] = Locate(index);
+        while (true) {
+            Slot* bucket = buckets_[b].load(std::memory_order_acquire);
+            if (bucket != nullptr && bucket[offset].ready.load(std::memory_order_acquire)) {
+                return *bucket[offset].Get();
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // Выделяет корзины под capacity элементов. Можно вызывать одновременно с записью
+    void Reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        const size_t last = Locate(capacity - 1).first;
+        for (size_t b = 0; b <= last; ++b) {
+            EnsureBucket(b);
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора и возвращает ссылку на него.
+    // Если конструктор или выделение корзины бросит исключение, индекс не занимается
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<Type, Args&&...>) {
+            return Publish(std::forward<Args>(args)...);
+        } else {
+            Type item(std::forward<Args>(args)...);
+            return Publish(std::move(item));
+        }
+    }
+
+    // Разрушает все элементы, корзины остаются выделенными. Не допускает одновременной записи
+    void Clear() noexcept {
+        const size_t size = size_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < size; ++i) {
+            Slot* slot = FindSlot(i);
+            if (slot != nullptr && slot->ready.load(std::memory_order_relaxed)) {
+                AllocatorTraits::destroy(alloc_, slot->Get());
+                slot->ready.store(false, std::memory_order_relaxed);
+            }
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+    // Итераторы обходят индексы [0, GetSize()) на момент вызова end().
+    // Разыменование дожидается готовности элемента (см. Wait)
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    static constexpr size_t FIRST_BUCKET_SHIFT = 3;
+    static_assert(FIRST_BUCKET_SIZE == size_t{1} << FIRST_BUCKET_SHIFT);
+    static constexpr size_t BUCKET_COUNT = sizeof(size_t) * 8 - FIRST_BUCKET_SHIFT;
+
+    static constexpr size_t BucketSize(size_t bucket) noexcept {
+        return FIRST_BUCKET_SIZE << bucket;
+    }
+
+    // Корзина и смещение в ней для индекса: корзина b начинается с индекса
+    // FIRST_BUCKET_SIZE * (2^b - 1), поэтому номер корзины — старший бит index + FIRST_BUCKET_SIZE
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        const size_t position = index + FIRST_BUCKET_SIZE;
+#ifdef __GNUG__
+        const size_t high_bit = sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(position);
+#else
+        size_t high_bit = 0;
+        while ((position >> high_bit) > 1) {
+            ++high_bit;
+        }
+#endif
+        return {high_bit - FIRST_BUCKET_SHIFT, position - (size_t{1} << high_bit)};
+    }
+
+    Slot* FindSlot(size_t index) const noexcept {
+        const auto [b, offset] = Locate(index);
+        Slot* bucket = buckets_[b].load(std::memory_order_acquire);
+        if (bucket == nullptr) {
+            return nullptr;
+        }
+        return bucket + offset;
+    }
+
+    // Занимает следующий индекс, когда его корзина уже выделена, и создаёт в нём элемент
+    template <typename... Args>
+    Type& Publish(Args&&... args) {
+        size_t index = size_.load(std::memory_order_relaxed);
+        Slot* place = nullptr;
+        do {
+            const auto [b, offset] = Locate(index);
+            place = EnsureBucket(b) + offset;
+        } while (!size_.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+        Slot& slot = *place;
+        AllocatorTraits::construct(alloc_, slot.Get(), std::forward<Args>(args)...);
+        slot.ready.store(true, std::memory_order_release);
+        return *slot.Get();
+    }
+
+    // Возвращает корзину b, выделяя её при необходимости. Из потоков, выделивших корзину
+    // одновременно, побеждает один: остальные освобождают свою память и берут его корзину.
+    // Если выделить не удалось, корзина остаётся пустой и следующий вызов попробует снова
+    Slot* EnsureBucket(size_t b) {
+        Slot* bucket = buckets_[b].load(std::memory_order_acquire);
+        if (bucket == nullptr) {
+            Slot* fresh = AllocateBucket(BucketSize(b));
+            if (buckets_[b].compare_exchange_strong(bucket, fresh, std::memory_order_acq_rel)) {
+                return fresh;
+            }
+            FreeBucket(fresh, BucketSize(b));
+        }
+        return bucket;
+    }
+
+    Slot* AllocateBucket(size_t size) {
+        SlotAllocator slot_alloc(alloc_);
+        Slot* bucket = SlotTraits::allocate(slot_alloc, size);
+        for (size_t i = 0; i < size; ++i) {
+            ::new (static_cast<void*>(bucket + i)) Slot();
+        }
+        return bucket;
+    }
+
+    void FreeBucket(Slot* bucket, size_t size) noexcept {
+        SlotAllocator slot_alloc(alloc_);
+        std::destroy_n(bucket, size);
+        SlotTraits::deallocate(slot_alloc, bucket, size);
+    }
+
+    template <typename Value>
+    class BasicIterator {
+        using Owner = std::conditional_t<std::is_const_v<Value>, const ConcurrentSimpleVector, ConcurrentSimpleVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner), index_(index) {
+        }
+
+        // Итератор на изменяемые элементы приводится к итератору на константные
+        template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value> &&
+                                                              !std::is_same_v<Other, Value>>>
+        BasicIterator(const BasicIterator<Other>& other) noexcept
+        : owner_(other.owner_), index_(other.index_) {
+        }
+
+        reference operator*() const {
+            return const_cast<reference>(owner_->Wait(index_));
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+            return it += n;
+        }
+
+        friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+            return it += n;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <typename>
+        friend class BasicIterator;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    // Индексы занимаются раньше, чем создаются элементы: счётчик отделён от корзин,
+    // чтобы запись в него не сбрасывала их кэш-линию у читателей
+    alignas(64) std::atomic<size_t> size_{0};
+    alignas(64) std::atomic<Slot*> buckets_[BUCKET_COUNT] = {};
+    Allocator alloc_;
+};
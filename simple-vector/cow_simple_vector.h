@@ -0,0 +1,394 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Вектор с копированием при записи. Копии делят один буфер (SimpleVector со счётчиком
+// ссылок), поэтому копирование — O(1) без выделения памяти: удобно раздавать снимки
+// таблиц многим потокам. Первая изменяющая операция (неконстантные operator[], At, begin/end,
+// PushBack, Insert, Erase, Resize и т.д.) копию, делящую буфер, сначала отцепляет:
+// копирует элементы в собственный буфер. Счётчик атомарный, поэтому копии одного буфера
+// можно читать и изменять из разных потоков; один объект CowSimpleVector, как и SimpleVector,
+// из нескольких потоков одновременно изменять нельзя.
+// Ссылки и итераторы, полученные неконстантным доступом, нельзя использовать для записи
+// после того, как вектор скопирован: запись попадёт в общий буфер
+template <typename Type, typename Allocator = std::allocator<Type>>
+class CowSimpleVector {
+public:
+    using Items = SimpleVector<Type, Allocator>;
+    using Iterator = typename Items::Iterator;
+    using ConstIterator = typename Items::ConstIterator;
+    using AllocatorType = Allocator;
+
+    CowSimpleVector() noexcept = default;
+
+    explicit CowSimpleVector(const Allocator& alloc) noexcept
+    : alloc_(alloc) {
+    }
+
+    explicit CowSimpleVector(size_t size, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        if (size != 0) {
+            buffer_ = NewBuffer(size, alloc);
+        }
+    }
+
+    CowSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        if (size != 0) {
+            buffer_ = NewBuffer(size, value, alloc);
+        }
+    }
+
+    CowSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        if (init.size() != 0) {
+            buffer_ = NewBuffer(init, alloc);
+        }
+    }
+
+    // Забирает элементы готового вектора без копирования
+    explicit CowSimpleVector(Items&& items)
+    : alloc_(items.GetAllocator()) {
+        if (!items.IsEmpty()) {
+            buffer_ = NewBuffer(std::move(items));
+        }
+    }
+
+    // Делит буфер с other: O(1)
+    CowSimpleVector(const CowSimpleVector& other) noexcept
+    : buffer_(other.buffer_), alloc_(other.alloc_) {
+        if (buffer_ != nullptr) {
+            buffer_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowSimpleVector(CowSimpleVector&& other) noexcept
+    : buffer_(std::exchange(other.buffer_, nullptr)), alloc_(other.alloc_) {
+    }
+
+    ~CowSimpleVector() {
+        Release(buffer_);
+    }
+
+    CowSimpleVector& operator=(const CowSimpleVector& rhs) noexcept {
+        CowSimpleVector copy(rhs);
+        swap(copy);
+        return *this;
+    }
+
+    CowSimpleVector& operator=(CowSimpleVector&& rhs) noexcept {
+        CowSimpleVector moved(std::move(rhs));
+        swap(moved);
+        return *this;
+    }
+
+    Allocator GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    size_t GetSize() const noexcept {
+        return buffer_ == nullptr ? 0 : buffer_->items.GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return buffer_ == nullptr ? 0 : buffer_->items.GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Делит ли вектор буфер с другими копиями
+    bool IsShared() const noexcept {
+        return buffer_ != nullptr && buffer_->refs.load(std::memory_order_acquire) != 1;
+    }
+
+    // Число копий, делящих буфер (0 для вектора без буфера)
+    size_t GetUseCount() const noexcept {
+        return buffer_ == nullptr ? 0 : buffer_->refs.load(std::memory_order_acquire);
+    }
+
+    // Элементы только для чтения; не отцепляет буфер
+    const Items& Read() const noexcept {
+        return buffer_ == nullptr ? EmptyItems() : buffer_->items;
+    }
+
+    // Собственный изменяемый вектор: буфер отцепляется, если он общий
+    Items& Write() {
+        return Detach(0);
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return buffer_->items[index];
+    }
+
+    Type& operator[](size_t index) {
+        return Write()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        return Read().At(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return Write()[index];
+    }
+
+    // Общий буфер не копируется: вектор просто отказывается от него
+    void Clear() noexcept {
+        if (IsShared()) {
+            Release(std::exchange(buffer_, nullptr));
+        } else if (buffer_ != nullptr) {
+            buffer_->items.Clear();
+        }
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Detach(new_capacity - GetSize()).Reserve(new_capacity);
+        }
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size != GetSize()) {
+            Detach(new_size > GetSize() ? new_size - GetSize() : 0).Resize(new_size);
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        Buffer* old = nullptr;
+        Items& items = Detach(1, old);
+        BufferGuard guard{old};
+        return items.EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    void Append(InputIt first, InputIt last) {
+        Buffer* old = nullptr;
+        Items& items = Detach(0, old);
+        BufferGuard guard{old};
+        items.Append(first, last);
+    }
+
+    // Для пустого вектора ничего не делает, как SimpleVector::PopBack.
+    // Не noexcept: у разделённого буфера копирует оставшиеся элементы
+    void PopBack() {
+        if (GetSize() == 0) {
+            return;
+        }
+        if (IsShared()) {
+            // Копируем все элементы, кроме последнего
+            Items items(::Reserve(GetSize() - 1), alloc_);
+            items.Append(buffer_->items.begin(), buffer_->items.end() - 1);
+            Replace(std::move(items));
+        } else {
+            buffer_->items.PopBack();
+        }
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Insert(pos, size_t{1}, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t index = pos - cbegin();
+        Buffer* old = nullptr;
+        Items& items = Detach(1, old);
+        BufferGuard guard{old};
+        return items.Insert(items.begin() + index, std::move(value));
+    }
+
+    Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        const size_t index = pos - cbegin();
+        // value может лежать в общем буфере: он живёт, пока держим старую ссылку
+        Buffer* old = nullptr;
+        Items& items = Detach(count, old);
+        BufferGuard guard{old};
+        return items.Insert(items.begin() + index, count, value);
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        const size_t index = pos - cbegin();
+        Buffer* old = nullptr;
+        Items& items = Detach(0, old);
+        BufferGuard guard{old};
+        return items.Insert(items.begin() + index, first, last);
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    // Общий буфер при удалении не копируется целиком: новый буфер собирается
+    // из элементов до и после удаляемого диапазона
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t from = first - cbegin();
+        const size_t to = last - cbegin();
+        if (IsShared()) {
+            const Items& shared = buffer_->items;
+            Items items(::Reserve(shared.GetSize() - (to - from)), alloc_);
+            items.Append(shared.begin(), shared.begin() + from);
+            items.Append(shared.begin() + to, shared.end());
+            Replace(std::move(items));
+            return buffer_->items.begin() + from;
+        }
+        Items& items = Write();
+        return items.Erase(items.begin() + from, items.begin() + to);
+    }
+
+    void swap(CowSimpleVector& other) noexcept {
+        std::swap(buffer_, other.buffer_);
+        std::swap(alloc_, other.alloc_);
+    }
+
+    Iterator begin() {
+        return Write().begin();
+    }
+
+    Iterator end() {
+        return Write().end();
+    }
+
+    ConstIterator begin() const noexcept {
+        return Read().begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return Read().end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    friend bool operator==(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return lhs.buffer_ == rhs.buffer_ || lhs.Read() == rhs.Read();
+    }
+
+    friend bool operator!=(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return lhs.Read() < rhs.Read();
+    }
+
+    friend bool operator>(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    // Буфер со счётчиком копий, которые его делят
+    struct Buffer {
+        template <typename... Args>
+        explicit Buffer(Args&&... args)
+        : items(std::forward<Args>(args)...) {
+        }
+
+        std::atomic<size_t> refs{1};
+        Items items;
+    };
+
+    using BufferAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Buffer>;
+    using BufferTraits = std::allocator_traits<BufferAllocator>;
+
+    // Отпускает старый буфер после операции, даже если она бросила исключение
+    struct BufferGuard {
+        Buffer* buffer;
+
+        ~BufferGuard() {
+            Release(buffer);
+        }
+    };
+
+    static const Items& EmptyItems() noexcept {
+        static const Items empty;
+        return empty;
+    }
+
+    template <typename... Args>
+    Buffer* NewBuffer(Args&&... args) {
+        BufferAllocator buffer_alloc(alloc_);
+        Buffer* buffer = BufferTraits::allocate(buffer_alloc, 1);
+        try {
+            BufferTraits::construct(buffer_alloc, buffer, std::forward<Args>(args)...);
+        } catch (...) {
+            BufferTraits::deallocate(buffer_alloc, buffer, 1);
+            throw;
+        }
+        return buffer;
+    }
+
+    // Последняя копия разрушает буфер. acq_rel: чтения и записи других копий
+    // завершаются до разрушения
+    static void Release(Buffer* buffer) noexcept {
+        if (buffer != nullptr && buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            BufferAllocator buffer_alloc(buffer->items.GetAllocator());
+            BufferTraits::destroy(buffer_alloc, buffer);
+            BufferTraits::deallocate(buffer_alloc, buffer, 1);
+        }
+    }
+
+    // Делает буфер собственным; extra — сколько элементов операция собирается добавить,
+    // чтобы копия сразу получила нужную вместимость. Старый общий буфер возвращается
+    // в old: вызывающий отпускает его после операции, которая может читать из него аргументы
+    Items& Detach(size_t extra, Buffer*& old) {
+        if (buffer_ == nullptr) {
+            buffer_ = NewBuffer(alloc_);
+        } else if (IsShared()) {
+            const Items& shared = buffer_->items;
+            Items items(::Reserve(shared.GetSize() + extra), alloc_);
+            items.Append(shared.begin(), shared.end());
+            old = std::exchange(buffer_, NewBuffer(std::move(items)));
+        }
+        return buffer_->items;
+    }
+
+    Items& Detach(size_t extra) {
+        Buffer* old = nullptr;
+        Items& items = Detach(extra, old);
+        Release(old);
+        return items;
+    }
+
+    void Replace(Items&& items) {
+        Buffer* fresh = NewBuffer(std::move(items));
+        Release(std::exchange(buffer_, fresh));
+    }
+
+    Buffer* buffer_ = nullptr;
+    Allocator alloc_;
+};
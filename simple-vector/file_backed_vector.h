@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Вектор, хранящий элементы в файле, отображённом в память (Linux/POSIX).
+// Файл начинается с заголовка FileBackedHeader, за которым лежат capacity элементов.
+// Повторное открытие файла не требует десериализации: элементы читаются прямо из отображения.
+// При нехватке места файл удлиняется через ftruncate и отображается заново,
+// поэтому итераторы и ссылки инвалидируются так же, как при росте SimpleVector.
+// Изменения попадают в файл через общее отображение; Sync() дожидается их записи на диск
+struct FileBackedHeader {
+    static constexpr char MAGIC[8] = {'S', 'V', 'E', 'C', 'T', 'O', 'R', '1'};
+
+    char magic[8];
+    std::uint32_t element_size;
+    std::uint32_t header_size;
+    std::uint64_t size;
+    std::uint64_t capacity;
+};
+
+template <typename Type>
+class FileBackedVector {
+    static_assert(std::is_trivially_copyable_v<Type>,
+                  "FileBackedVector stores elements as raw bytes and needs a trivially copyable type");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Размер заголовка с выравниванием, после которого начинаются элементы
+    static constexpr size_t HEADER_SIZE = std::max<size_t>(64, alignof(Type));
+
+    // Открывает файл path или создаёт его, если он не существует.
+    // Выбрасывает std::system_error при ошибке ввода-вывода и std::runtime_error,
+    // если файл не является вектором с элементами размера sizeof(Type)
+    explicit FileBackedVector(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            ThrowSystemError("open");
+        }
+        try {
+            struct stat st {};
+            if (::fstat(fd_, &st) != 0) {
+                ThrowSystemError("fstat");
+            }
+            if (st.st_size == 0) {
+                Truncate(0);
+                Map(0);
+                std::memcpy(header_->magic, FileBackedHeader::MAGIC, sizeof(header_->magic));
+                header_->element_size = sizeof(Type);
+                header_->header_size = HEADER_SIZE;
+                header_->size = 0;
+                header_->capacity = 0;
+            } else {
+                if (static_cast<size_t>(st.st_size) < HEADER_SIZE) {
+                    throw std::runtime_error("File is too small for a vector header: " + path);
+                }
+                Map(0);
+                const size_t capacity = ValidateHeader(static_cast<size_t>(st.st_size), path);
+                Remap(capacity);
+            }
+        } catch (...) {
+            Unmap();
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    FileBackedVector(const FileBackedVector&) = delete;
+    FileBackedVector& operator=(const FileBackedVector&) = delete;
+
+    FileBackedVector(FileBackedVector&& other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      header_(std::exchange(other.header_, nullptr)),
+      mapped_bytes_(std::exchange(other.mapped_bytes_, 0)) {
+    }
+
+    FileBackedVector& operator=(FileBackedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Close();
+            fd_ = std::exchange(rhs.fd_, -1);
+            header_ = std::exchange(rhs.header_, nullptr);
+            mapped_bytes_ = std::exchange(rhs.mapped_bytes_, 0);
+        }
+        return *this;
+    }
+
+    // Снимает отображение и закрывает файл. Записанные данные остаются в файле
+    ~FileBackedVector() {
+        Close();
+    }
+
+    // Вектор, из которого переместили файл, пуст и не имеет вместимости
+    size_t GetSize() const noexcept {
+        return header_ == nullptr ? 0 : header_->size;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return header_ == nullptr ? 0 : header_->capacity;
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        return Data()[index];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return Data()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return Data()[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return Data()[index];
+    }
+
+    // Обнуляет размер, не изменяя вместимость и длину файла
+    void Clear() noexcept {
+        if (header_ != nullptr) {
+            header_->size = 0;
+        }
+    }
+
+    // Удлиняет файл под new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Truncate(new_capacity);
+            Remap(new_capacity);
+            header_->capacity = new_capacity;
+        }
+    }
+
+    // Изменяет размер. Новые элементы инициализируются значением по умолчанию
+    void Resize(size_t new_size) {
+        if (new_size > GetCapacity()) {
+            Reserve(std::max(new_size, GetCapacity() * 2));
+        }
+        if (new_size > GetSize()) {
+            std::fill(Data() + GetSize(), Data() + new_size, Type{});
+        }
+        header_->size = new_size;
+    }
+
+    // Добавляет элемент в конец. При нехватке места удваивает вместимость файла
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        // Значение создаётся до роста: args могут ссылаться на элементы в старом отображении
+        Type value(std::forward<Args>(args)...);
+        if (GetSize() == GetCapacity()) {
+            Reserve(GetCapacity() == 0 ? 1 : GetCapacity() * 2);
+        }
+        Type* place = Data() + GetSize();
+        std::memcpy(static_cast<void*>(place), &value, sizeof(Type));
+        ++header_->size;
+        return *place;
+    }
+
+    void PopBack() noexcept {
+        if (GetSize() != 0) {
+            --header_->size;
+        }
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = static_cast<size_t>(pos - Data());
+        assert(index < GetSize());
+        std::memmove(static_cast<void*>(Data() + index), Data() + index + 1,
+                     (GetSize() - index - 1) * sizeof(Type));
+        --header_->size;
+        return Data() + index;
+    }
+
+    // Сбрасывает изменённые страницы в файл. При async == false дожидается окончания записи
+    void Sync(bool async = false) {
+        if (::msync(header_, mapped_bytes_, async ? MS_ASYNC : MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+
+    Iterator begin() noexcept {
+        return Data();
+    }
+
+    Iterator end() noexcept {
+        return Data() + GetSize();
+    }
+
+    ConstIterator begin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator end() const noexcept {
+        return Data() + GetSize();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return Data();
+    }
+
+    ConstIterator cend() const noexcept {
+        return Data() + GetSize();
+    }
+
+private:
+    [[noreturn]] static void ThrowSystemError(const char* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    static size_t FileBytes(size_t capacity) noexcept {
+        return HEADER_SIZE + capacity * sizeof(Type);
+    }
+
+    Type* Data() noexcept {
+        return reinterpret_cast<Type*>(reinterpret_cast<char*>(header_) + HEADER_SIZE);
+    }
+
+    const Type* Data() const noexcept {
+        return reinterpret_cast<const Type*>(reinterpret_cast<const char*>(header_) + HEADER_SIZE);
+    }
+
+    // Проверяет заголовок уже отображённого файла и возвращает вместимость
+    size_t ValidateHeader(size_t file_bytes, const std::string& path) const {
+        if (std::memcmp(header_->magic, FileBackedHeader::MAGIC, sizeof(header_->magic)) != 0) {
+            throw std::runtime_error("Not a FileBackedVector file: " + path);
+        }
+        if (header_->element_size != sizeof(Type) || header_->header_size != HEADER_SIZE) {
+            throw std::runtime_error("Element size mismatch in " + path);
+        }
+        // Вместимость проверяется до умножения: у испорченного заголовка FileBytes переполнился бы
+        // и прошёл бы сравнение с длиной файла
+        if (header_->size > header_->capacity ||
+            header_->capacity > (std::numeric_limits<size_t>::max() - HEADER_SIZE) / sizeof(Type) ||
+            FileBytes(header_->capacity) > file_bytes) {
+            throw std::runtime_error("Corrupted FileBackedVector header in " + path);
+        }
+        return header_->capacity;
+    }
+
+    void Truncate(size_t capacity) {
+        if (::ftruncate(fd_, static_cast<off_t>(FileBytes(capacity))) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+    }
+
+    void Map(size_t capacity) {
+        const size_t bytes = FileBytes(capacity);
+        void* ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (ptr == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        header_ = static_cast<FileBackedHeader*>(ptr);
+        mapped_bytes_ = bytes;
+    }
+
+    void Unmap() noexcept {
+        if (header_) {
+            ::munmap(header_, mapped_bytes_);
+            header_ = nullptr;
+            mapped_bytes_ = 0;
+        }
+    }
+
+    // Отображает файл заново под capacity элементов. Старое отображение снимается
+    // только после успешного создания нового, поэтому при ошибке вектор остаётся целым
+    void Remap(size_t capacity) {
+        FileBackedHeader* old_header = header_;
+        const size_t old_bytes = mapped_bytes_;
+        Map(capacity);
+        ::munmap(old_header, old_bytes);
+    }
+
+    void Close() noexcept {
+        Unmap();
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    FileBackedHeader* header_ = nullptr;
+    size_t mapped_bytes_ = 0;
+};
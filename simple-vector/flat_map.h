@@ -0,0 +1,468 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "flat_set.h"
+#include "simple_vector.h"
+
+// Отсортированный словарь на двух SimpleVector: ключи и значения лежат в отдельных массивах
+// с общим порядком. Поиск читает только плотный массив ключей (BranchlessLowerBound),
+// значения затрагиваются лишь у найденного ключа. Обход — последовательное чтение двух массивов.
+// Разыменование итератора даёт пару ссылок std::pair<const Key&, Value&>.
+// Вставка одного ключа сдвигает хвосты обоих массивов за O(n); пакетная вставка
+// Insert(first, last) сортирует новые пары и сливает их с имеющимися в новые массивы
+// за O(n + k log k). Если вставка в массив значений бросит исключение,
+// вставленный ключ удаляется и словарь не меняется
+template <typename Key, typename Value, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+class FlatMap {
+    template <bool IsConst>
+    class BasicIterator;
+
+    using ValueAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+
+public:
+    using KeyStorage = SimpleVector<Key, Allocator>;
+    using ValueStorage = SimpleVector<Value, ValueAllocator>;
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp, const Allocator& alloc = Allocator())
+    : keys_(alloc), values_(ValueAllocator(alloc)), comp_(comp) {
+    }
+
+    // Строит словарь из неупорядоченных пар: сортирует их один раз,
+    // из пар с равными ключами остаётся первая
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+    : FlatMap(comp, alloc) {
+        Insert(first, last);
+    }
+
+    FlatMap(std::initializer_list<std::pair<Key, Value>> init, const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+    : FlatMap(init.begin(), init.end(), comp, alloc) {
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Ключи по возрастанию одним непрерывным массивом
+    const KeyStorage& GetKeys() const noexcept {
+        return keys_;
+    }
+
+    // Значения в порядке ключей
+    const ValueStorage& GetValues() const noexcept {
+        return values_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+        values_.Reserve(new_capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    Iterator LowerBound(const Key& key) {
+        return MakeIterator(LowerBoundIndex(key));
+    }
+
+    ConstIterator LowerBound(const Key& key) const {
+        return MakeIterator(LowerBoundIndex(key));
+    }
+
+    Iterator UpperBound(const Key& key) {
+        return MakeIterator(UpperBoundIndex(key));
+    }
+
+    ConstIterator UpperBound(const Key& key) const {
+        return MakeIterator(UpperBoundIndex(key));
+    }
+
+    // Возвращает end(), если ключа нет
+    Iterator Find(const Key& key) {
+        return MakeIterator(FindIndex(key));
+    }
+
+    ConstIterator Find(const Key& key) const {
+        return MakeIterator(FindIndex(key));
+    }
+
+    bool Contains(const Key& key) const {
+        return FindIndex(key) != GetSize();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Выбрасывает исключение std::out_of_range, если ключа нет
+    Value& At(const Key& key) {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            throw std::out_of_range("Key is not found!");
+        }
+        return values_[index];
+    }
+
+    const Value& At(const Key& key) const {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            throw std::out_of_range("Key is not found!");
+        }
+        return values_[index];
+    }
+
+    // Значение по ключу; отсутствующий ключ вставляется со значением по умолчанию
+    Value& operator[](const Key& key) {
+        return TryEmplace(key).first->second;
+    }
+
+    Value& operator[](Key&& key) {
+        return TryEmplace(std::move(key)).first->second;
+    }
+
+    // Вставляет пару, если ключа нет. Возвращает итератор на пару с этим ключом и признак вставки
+    std::pair<Iterator, bool> Insert(const std::pair<Key, Value>& item) {
+        return TryEmplace(item.first, item.second);
+    }
+
+    std::pair<Iterator, bool> Insert(std::pair<Key, Value>&& item) {
+        return TryEmplace(std::move(item.first), std::move(item.second));
+    }
+
+    // Создаёт значение из args, только если ключа нет
+    template <typename K, typename... Args>
+    std::pair<Iterator, bool> TryEmplace(K&& key, Args&&... args) {
+        const size_t index = LowerBoundIndex(key);
+        if (index != GetSize() && !comp_(key, keys_[index])) {
+            return {MakeIterator(index), false};
+        }
+        return {EmplaceAt(index, std::forward<K>(key), std::forward<Args>(args)...), true};
+    }
+
+    // Вставляет пару или присваивает значение имеющемуся ключу
+    template <typename K, typename V>
+    std::pair<Iterator, bool> InsertOrAssign(K&& key, V&& value) {
+        const size_t index = LowerBoundIndex(key);
+        if (index != GetSize() && !comp_(key, keys_[index])) {
+            values_[index] = std::forward<V>(value);
+            return {MakeIterator(index), false};
+        }
+        return {EmplaceAt(index, std::forward<K>(key), std::forward<V>(value)), true};
+    }
+
+    // Пакетная вставка пар. Новые пары сортируются, из повторов остаётся первая,
+    // затем они сливаются с имеющимися в новые массивы за один проход. Ключи, которые
+    // уже есть, не меняются. Если сравнение, копирование или выделение памяти бросит
+    // исключение, словарь не меняется
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    void Insert(InputIt first, InputIt last) {
+        using Item = std::pair<Key, Value>;
+        using ItemAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Item>;
+        using IndexAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<size_t>;
+        SimpleVector<Item, ItemAllocator> batch{ItemAllocator(keys_.GetAllocator())};
+        batch.Append(first, last);
+        auto by_key = [this](const Item& lhs, const Item& rhs) {
+            return comp_(lhs.first, rhs.first);
+        };
+        std::stable_sort(batch.begin(), batch.end(), by_key);
+        batch.Erase(std::unique(batch.begin(), batch.end(), [this](const Item& lhs, const Item& rhs) {
+            return !comp_(lhs.first, rhs.first);
+        }), batch.end());
+
+        // Сначала все сравнения: для каждой новой пары — число имеющихся ключей перед ней
+        // или DUPLICATE, если такой ключ уже есть. Слияние ниже comp_ не вызывает, поэтому
+        // исключение из сравнения не застанет пары уже перемещёнными из keys_ и values_
+        constexpr size_t DUPLICATE = std::numeric_limits<size_t>::max();
+        SimpleVector<size_t, IndexAllocator> positions(batch.GetSize(), IndexAllocator(keys_.GetAllocator()));
+        size_t i = 0;
+        for (size_t j = 0; j < batch.GetSize(); ++j) {
+            while (i < keys_.GetSize() && comp_(keys_[i], batch[j].first)) {
+                ++i;
+            }
+            positions[j] = i < keys_.GetSize() && !comp_(batch[j].first, keys_[i]) ? DUPLICATE : i;
+        }
+
+        KeyStorage keys(::Reserve(keys_.GetSize() + batch.GetSize()), keys_.GetAllocator());
+        ValueStorage values(::Reserve(keys_.GetSize() + batch.GetSize()), values_.GetAllocator());
+        // Имеющиеся пары переносятся перемещением, только если не бросает ни перемещение ключа,
+        // ни перемещение значения. Иначе исключение из значения застало бы ключ уже перемещённым
+        // из keys_, поэтому оба массива копируются
+        constexpr bool NOTHROW_MOVE_PAIRS =
+            std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_constructible_v<Value>;
+        auto take_existing = [&](size_t until) {
+            for (; i < until; ++i) {
+                if constexpr (NOTHROW_MOVE_PAIRS) {
+                    keys.PushBack(std::move(keys_[i]));
+                    values.PushBack(std::move(values_[i]));
+                } else {
+                    keys.PushBack(std::as_const(keys_[i]));
+                    values.PushBack(std::as_const(values_[i]));
+                }
+            }
+        };
+        i = 0;
+        for (size_t j = 0; j < batch.GetSize(); ++j) {
+            if (positions[j] == DUPLICATE) {
+                continue;
+            }
+            take_existing(positions[j]);
+            keys.PushBack(std::move(batch[j].first));
+            values.PushBack(std::move(batch[j].second));
+        }
+        take_existing(keys_.GetSize());
+        keys_.swap(keys);
+        values_.swap(values);
+    }
+
+    void Insert(std::initializer_list<std::pair<Key, Value>> init) {
+        Insert(init.begin(), init.end());
+    }
+
+    // Удаляет ключ, возвращает число удалённых (0 или 1)
+    size_t Erase(const Key& key) {
+        const size_t index = FindIndex(key);
+        if (index == GetSize()) {
+            return 0;
+        }
+        Erase(MakeIterator(index));
+        return 1;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t from = first - cbegin();
+        const size_t to = last - cbegin();
+        keys_.Erase(keys_.begin() + from, keys_.begin() + to);
+        values_.Erase(values_.begin() + from, values_.begin() + to);
+        return MakeIterator(from);
+    }
+
+    void swap(FlatMap& other) noexcept {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        std::swap(comp_, other.comp_);
+    }
+
+    Iterator begin() noexcept {
+        return MakeIterator(0);
+    }
+
+    Iterator end() noexcept {
+        return MakeIterator(GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return MakeIterator(0);
+    }
+
+    ConstIterator end() const noexcept {
+        return MakeIterator(GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs) {
+        return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_;
+    }
+
+    friend bool operator!=(const FlatMap& lhs, const FlatMap& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    size_t LowerBoundIndex(const Key& key) const {
+        return BranchlessLowerBound(keys_.GetData(), keys_.GetSize(), key, comp_) - keys_.GetData();
+    }
+
+    size_t UpperBoundIndex(const Key& key) const {
+        const size_t index = LowerBoundIndex(key);
+        return index != GetSize() && !comp_(key, keys_[index]) ? index + 1 : index;
+    }
+
+    // Возвращает GetSize(), если ключа нет
+    size_t FindIndex(const Key& key) const {
+        const size_t index = LowerBoundIndex(key);
+        return index != GetSize() && !comp_(key, keys_[index]) ? index : GetSize();
+    }
+
+    Iterator MakeIterator(size_t index) noexcept {
+        return Iterator(keys_.GetData() + index, values_.GetData() + index);
+    }
+
+    ConstIterator MakeIterator(size_t index) const noexcept {
+        return ConstIterator(keys_.GetData() + index, values_.GetData() + index);
+    }
+
+    template <typename K, typename... Args>
+    Iterator EmplaceAt(size_t index, K&& key, Args&&... args) {
+        keys_.Insert(keys_.begin() + index, std::forward<K>(key));
+        try {
+            values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+        } catch (...) {
+            keys_.Erase(keys_.begin() + index);
+            throw;
+        }
+        return MakeIterator(index);
+    }
+
+    // Итератор по парам: указатели на ключ и на значение с тем же номером
+    template <bool IsConst>
+    class BasicIterator {
+        using ValuePointer = std::conditional_t<IsConst, const Value*, Value*>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, std::conditional_t<IsConst, const Value&, Value&>>;
+
+        // Пара ссылок живёт во временном объекте, поэтому -> возвращает его обёртку
+        struct pointer {
+            reference ref;
+
+            const reference* operator->() const noexcept {
+                return &ref;
+            }
+        };
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(const Key* key, ValuePointer value) noexcept
+        : key_(key), value_(value) {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+        : key_(other.key_), value_(other.value_) {
+        }
+
+        reference operator*() const noexcept {
+            return {*key_, *value_};
+        }
+
+        pointer operator->() const noexcept {
+            return {**this};
+        }
+
+        reference operator[](difference_type n) const noexcept {
+            return {key_[n], value_[n]};
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++key_;
+            ++value_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --key_;
+            --value_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old = *this;
+            --*this;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type n) noexcept {
+            key_ += n;
+            value_ += n;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type n) noexcept {
+            key_ -= n;
+            value_ -= n;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+            return it += n;
+        }
+
+        friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+            return it += n;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.key_ - rhs.key_;
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.key_ == rhs.key_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.key_ != rhs.key_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.key_ < rhs.key_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <bool>
+        friend class BasicIterator;
+
+        const Key* key_ = nullptr;
+        ValuePointer value_ = nullptr;
+    };
+
+    KeyStorage keys_;
+    ValueStorage values_;
+    [[no_unique_address]] Compare comp_{};
+};
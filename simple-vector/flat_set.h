@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Нижняя граница key в отсортированном массиве [first, first + count) без ветвлений по результату
+// сравнения: на каждом шаге диапазон делится пополам, а выбор половины компилятор делает
+// условной пересылкой (cmov). Число шагов — ровно ceil(log2(count)), ошибок предсказания
+// переходов нет, поэтому на таблицах до размеров кэша поиск заметно быстрее std::lower_bound
+template <typename T, typename Key, typename Compare>
+const T* BranchlessLowerBound(const T* first, size_t count, const Key& key, Compare comp) {
+    if (count == 0) {
+        return first;
+    }
+    while (count > 1) {
+        const size_t half = count / 2;
+        first = comp(first[half], key) ? first + half : first;
+        count -= half;
+    }
+    return first + (comp(*first, key) ? 1 : 0);
+}
+
+// Отсортированное множество уникальных ключей в непрерывном SimpleVector.
+// Поиск — двоичный без ветвлений (BranchlessLowerBound), обход — последовательное чтение
+// памяти без переходов по указателям, как у std::set. Вставка одного ключа сдвигает хвост
+// за O(n); для пакетной вставки есть Insert(first, last): новые ключи сортируются
+// и сливаются с имеющимися за один проход, O(n + k log k).
+// Конструктор из неупорядоченного диапазона сортирует и убирает повторы один раз.
+// Ключи изменять нельзя: итераторы указывают на константные ключи
+template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+class FlatSet {
+public:
+    using Storage = SimpleVector<Key, Allocator>;
+    using Iterator = typename Storage::ConstIterator;
+    using ConstIterator = typename Storage::ConstIterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp, const Allocator& alloc = Allocator())
+    : keys_(alloc), comp_(comp) {
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+    : keys_(alloc), comp_(comp) {
+        keys_.Append(first, last);
+        MergeTail(0);
+    }
+
+    FlatSet(std::initializer_list<Key> init, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+    : FlatSet(init.begin(), init.end(), comp, alloc) {
+    }
+
+    // Забирает ключи из вектора, сортирует их и убирает повторы
+    explicit FlatSet(Storage keys, const Compare& comp = Compare())
+    : keys_(std::move(keys)), comp_(comp) {
+        MergeTail(0);
+    }
+
+    size_t GetSize() const noexcept {
+        return keys_.GetSize();
+    }
+
+    size_t GetCapacity() const noexcept {
+        return keys_.GetCapacity();
+    }
+
+    bool IsEmpty() const noexcept {
+        return keys_.IsEmpty();
+    }
+
+    // Ключи по возрастанию одним непрерывным массивом
+    const Storage& GetStorage() const noexcept {
+        return keys_;
+    }
+
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+    }
+
+    // Первый ключ, не меньший key
+    ConstIterator LowerBound(const Key& key) const {
+        const Key* found = BranchlessLowerBound(keys_.GetData(), keys_.GetSize(), key, comp_);
+        return keys_.begin() + (found - keys_.GetData());
+    }
+
+    // Первый ключ, больший key
+    ConstIterator UpperBound(const Key& key) const {
+        ConstIterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it + 1 : it;
+    }
+
+    // Возвращает end(), если ключа нет
+    ConstIterator Find(const Key& key) const {
+        ConstIterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Вставляет ключ, если его нет. Возвращает итератор на ключ и признак вставки
+    std::pair<Iterator, bool> Insert(const Key& key) {
+        return InsertKey(key);
+    }
+
+    std::pair<Iterator, bool> Insert(Key&& key) {
+        return InsertKey(std::move(key));
+    }
+
+    template <typename... Args>
+    std::pair<Iterator, bool> Emplace(Args&&... args) {
+        return InsertKey(Key(std::forward<Args>(args)...));
+    }
+
+    // Пакетная вставка: ключи дописываются в конец, сортируются и сливаются с имеющимися
+    // одним проходом вместо k сдвигов хвоста. Из равных ключей остаётся тот, что был раньше
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    void Insert(InputIt first, InputIt last) {
+        const size_t old_size = keys_.GetSize();
+        try {
+            keys_.Append(first, last);
+        } catch (...) {
+            keys_.Erase(keys_.begin() + old_size, keys_.end());
+            throw;
+        }
+        MergeTail(old_size);
+    }
+
+    void Insert(std::initializer_list<Key> init) {
+        Insert(init.begin(), init.end());
+    }
+
+    // Удаляет ключ, возвращает число удалённых (0 или 1)
+    size_t Erase(const Key& key) {
+        ConstIterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        Erase(it);
+        return 1;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        return keys_.Erase(pos);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        return keys_.Erase(first, last);
+    }
+
+    void swap(FlatSet& other) noexcept {
+        keys_.swap(other.keys_);
+        std::swap(comp_, other.comp_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return keys_.end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    friend bool operator==(const FlatSet& lhs, const FlatSet& rhs) {
+        return lhs.keys_ == rhs.keys_;
+    }
+
+    friend bool operator!=(const FlatSet& lhs, const FlatSet& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // Лексикографическое сравнение в порядке самого множества, то есть через Compare
+    friend bool operator<(const FlatSet& lhs, const FlatSet& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.comp_);
+    }
+
+    friend bool operator>(const FlatSet& lhs, const FlatSet& rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const FlatSet& lhs, const FlatSet& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const FlatSet& lhs, const FlatSet& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    template <typename K>
+    std::pair<Iterator, bool> InsertKey(K&& key) {
+        ConstIterator it = LowerBound(key);
+        if (it != end() && !comp_(key, *it)) {
+            return {it, false};
+        }
+        return {keys_.Insert(it, std::forward<K>(key)), true};
+    }
+
+    // Ключи [0, sorted) упорядочены и уникальны. Сортирует хвост, сливает его с ними
+    // и убирает повторы, оставляя из равных ключей более ранний
+    void MergeTail(size_t sorted) {
+        Key* first = keys_.GetData();
+        Key* middle = first + sorted;
+        Key* last = first + keys_.GetSize();
+        if (middle == last) {
+            return;
+        }
+        std::stable_sort(middle, last, comp_);
+        std::inplace_merge(first, middle, last, comp_);
+        Key* unique_end = std::unique(first, last, [this](const Key& lhs, const Key& rhs) {
+            return !comp_(lhs, rhs);
+        });
+        keys_.Erase(keys_.begin() + (unique_end - first), keys_.end());
+    }
+
+    Storage keys_;
+    [[no_unique_address]] Compare comp_{};
+};
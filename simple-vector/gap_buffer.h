@@ -0,0 +1,482 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "array_ptr.h"
+#include "index_iterator.h"
+#include "simple_vector.h"
+
+// Вектор с разрывом (gap buffer) для правок в одном месте — «у курсора».
+// Свободная память буфера не лежит в конце, как у SimpleVector, а образует разрыв
+// в позиции последней правки. Вставка в разрыв и удаление рядом с ним стоят O(1),
+// перенос разрыва на k позиций — k перемещений элементов. Поэтому серия вставок или
+// удалений в одной точке (текстовый редактор, слияние, очередь с приоритетом у головы)
+// стоит амортизированно O(1) на операцию вместо O(n) у SimpleVector::Insert.
+// Буфер кольцевой: разрыв в конце и разрыв в начале — одно и то же место шва кольца,
+// поэтому разрыв переходит между концом и началом за O(1), а PushBack, PushFront,
+// PopBack и PopFront стоят O(1) при любом положении разрыва, кроме середины.
+// Доступ по индексу — O(1): к физической позиции добавляется размер разрыва,
+// если индекс лежит за ним. Итераторы хранят буфер и номер элемента
+template <typename Type, typename Allocator = std::allocator<Type>>
+class GapBuffer {
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+public:
+    using Iterator = IndexIterator<GapBuffer, Type>;
+    using ConstIterator = IndexIterator<GapBuffer, const Type>;
+    using AllocatorType = Allocator;
+
+    GapBuffer() noexcept = default;
+
+    explicit GapBuffer(const Allocator& alloc) noexcept
+    : data_(alloc) {
+    }
+
+    explicit GapBuffer(size_t size, const Allocator& alloc = Allocator())
+    : GapBuffer(alloc) {
+        Resize(size);
+    }
+
+    GapBuffer(size_t size, const Type& value, const Allocator& alloc = Allocator())
+    : GapBuffer(alloc) {
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(value);
+        }
+    }
+
+    GapBuffer(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+    : GapBuffer(alloc) {
+        Reserve(init.size());
+        for (const Type& value : init) {
+            PushBack(value);
+        }
+    }
+
+    GapBuffer(const GapBuffer& other)
+    : GapBuffer(AllocatorTraits::select_on_container_copy_construction(other.data_.GetAllocator())) {
+        Reserve(other.size_);
+        for (const Type& value : other) {
+            PushBack(value);
+        }
+    }
+
+    GapBuffer(GapBuffer&& other) noexcept
+    : data_(std::move(other.data_)),
+      front_(std::exchange(other.front_, 0)),
+      gap_pos_(std::exchange(other.gap_pos_, 0)),
+      size_(std::exchange(other.size_, 0)) {
+    }
+
+    ~GapBuffer() {
+        Clear();
+    }
+
+    GapBuffer& operator=(const GapBuffer& rhs) {
+        if (this != &rhs) {
+            GapBuffer copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    GapBuffer& operator=(GapBuffer&& rhs) noexcept {
+        if (this != &rhs) {
+            GapBuffer moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    Allocator GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    size_t GetCapacity() const noexcept {
+        return data_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Индекс, перед которым сейчас стоит разрыв. Вставка в эту позицию не переносит элементов
+    size_t GetGapPosition() const noexcept {
+        return gap_pos_;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        return data_[SlotOf(index)];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return data_[SlotOf(index)];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    // Разрушает элементы, память остаётся выделенной
+    void Clear() noexcept {
+        for (size_t i = 0; i < size_; ++i) {
+            AllocatorTraits::destroy(data_.GetAllocator(), &(*this)[i]);
+        }
+        front_ = 0;
+        gap_pos_ = 0;
+        size_ = 0;
+    }
+
+    // Разрыв остаётся на прежнем месте
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Grow(new_capacity, gap_pos_);
+        }
+    }
+
+    // Новые элементы создаются значением по умолчанию в конце. Если конструктор бросит
+    // исключение, созданные элементы разрушаются и размер не меняется
+    void Resize(size_t new_size) {
+        const size_t old_size = size_;
+        Reserve(new_size);
+        try {
+            while (size_ < new_size) {
+                EmplaceBack();
+            }
+        } catch (...) {
+            while (size_ > old_size) {
+                PopBack();
+            }
+            throw;
+        }
+        while (size_ > new_size) {
+            PopBack();
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return *Emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    void PushFront(const Type& item) {
+        EmplaceFront(item);
+    }
+
+    void PushFront(Type&& item) {
+        EmplaceFront(std::move(item));
+    }
+
+    // Создаёт элемент в начале. Разрыв переносится в начало (из конца — за O(1)),
+    // элемент занимает последнюю ячейку разрыва, поэтому серия PushFront ничего не переносит
+    template <typename... Args>
+    Type& EmplaceFront(Args&&... args) {
+        if (size_ == GetCapacity() || gap_pos_ != 0) {
+            // Аргументы могут ссылаться на элементы буфера: сначала создаём значение
+            Type value(std::forward<Args>(args)...);
+            PrepareGap(0);
+            return ConstructAt(Wrap(front_ + GapSize() - 1), std::move(value));
+        }
+        return ConstructAt(Wrap(front_ + GapSize() - 1), std::forward<Args>(args)...);
+    }
+
+    // Удаление переносит разрыв к удаляемому элементу. Для типов, перемещение которых
+    // может бросить исключение, перенос копирует элементы и тоже может бросить;
+    // буфер при этом остаётся целым, меняется только положение разрыва.
+    // Для пустого буфера PopBack и PopFront ничего не делают, как SimpleVector::PopBack
+    void PopBack() noexcept(NOTHROW_RELOCATION) {
+        if (size_ == 0) {
+            return;
+        }
+        EraseAt(size_ - 1);
+    }
+
+    void PopFront() noexcept(NOTHROW_RELOCATION) {
+        if (size_ == 0) {
+            return;
+        }
+        EraseAt(0);
+    }
+
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Переносит разрыв к pos и создаёт элемент в его первой ячейке; разрыв остаётся за ним,
+    // так что следующая вставка после нового элемента ничего не переносит
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = pos - cbegin();
+        if (size_ == GetCapacity() || gap_pos_ != index) {
+            Type value(std::forward<Args>(args)...);
+            PrepareGap(index);
+            ConstructAt(Wrap(front_ + index), std::move(value));
+        } else {
+            ConstructAt(Wrap(front_ + index), std::forward<Args>(args)...);
+        }
+        ++gap_pos_;
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = pos - cbegin();
+        EraseAt(index);
+        return begin() + index;
+    }
+
+    // Разрыв переносится к first, удаляемые элементы присоединяются к нему
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t from = first - cbegin();
+        const size_t to = last - cbegin();
+        if (from != to) {
+            MoveGap(from);
+            for (size_t i = from; i < to; ++i) {
+                DestroyAfterGap();
+            }
+        }
+        return begin() + from;
+    }
+
+    void swap(GapBuffer& other) noexcept {
+        data_.swap(other.data_);
+        std::swap(front_, other.front_);
+        std::swap(gap_pos_, other.gap_pos_);
+        std::swap(size_, other.size_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    friend bool operator==(const GapBuffer& lhs, const GapBuffer& rhs) {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const GapBuffer& lhs, const GapBuffer& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const GapBuffer& lhs, const GapBuffer& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator>(const GapBuffer& lhs, const GapBuffer& rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const GapBuffer& lhs, const GapBuffer& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const GapBuffer& lhs, const GapBuffer& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    static constexpr bool USE_BYTEWISE_RELOCATION = CanRelocateBytewiseV<Type, Allocator>;
+    // Перенос разрыва не бросает исключений: элементы переносятся memcpy или перемещением без исключений
+    static constexpr bool NOTHROW_RELOCATION =
+        USE_BYTEWISE_RELOCATION || std::is_nothrow_move_constructible_v<Type>;
+
+    size_t GapSize() const noexcept {
+        return data_.GetSize() - size_;
+    }
+
+    // Приводит позицию из [0, 2 * capacity) к позиции в кольце
+    size_t Wrap(size_t slot) const noexcept {
+        return slot >= data_.GetSize() ? slot - data_.GetSize() : slot;
+    }
+
+    // Ячейка элемента index: элементы за разрывом сдвинуты на его размер
+    size_t SlotOf(size_t index) const noexcept {
+        return Wrap(front_ + index + (index >= gap_pos_ ? GapSize() : 0));
+    }
+
+    template <typename... Args>
+    Type& ConstructAt(size_t slot, Args&&... args) {
+        Type* place = data_.Get() + slot;
+        AllocatorTraits::construct(data_.GetAllocator(), place, std::forward<Args>(args)...);
+        ++size_;
+        return *place;
+    }
+
+    // Переносит элемент из ячейки from в свободную ячейку to
+    void Relocate(size_t from, size_t to) {
+        Type* source = data_.Get() + from;
+        Type* target = data_.Get() + to;
+        if constexpr (USE_BYTEWISE_RELOCATION) {
+            std::memcpy(static_cast<void*>(target), static_cast<const void*>(source), sizeof(Type));
+        } else {
+            AllocatorTraits::construct(data_.GetAllocator(), target, std::move_if_noexcept(*source));
+            AllocatorTraits::destroy(data_.GetAllocator(), source);
+        }
+    }
+
+    // Гарантирует свободную ячейку в разрыве и ставит разрыв перед index
+    void PrepareGap(size_t index) {
+        if (size_ == GetCapacity()) {
+            Grow(std::max<size_t>(1, GetCapacity() * 2), index);
+        } else {
+            MoveGap(index);
+        }
+    }
+
+    // Ставит разрыв перед index кратчайшим путём: напрямую или через шов кольца,
+    // где перенос разрыва из конца в начало и обратно меняет только front_.
+    // Каждый шаг переносит один элемент и сразу обновляет состояние, поэтому
+    // исключение из конструктора перемещения оставляет буфер целым
+    void MoveGap(size_t index) {
+        if (GapSize() == 0) {
+            gap_pos_ = index;
+            return;
+        }
+        const size_t direct = gap_pos_ > index ? gap_pos_ - index : index - gap_pos_;
+        const size_t through_front = gap_pos_ + (size_ - index);
+        const size_t through_back = (size_ - gap_pos_) + index;
+        if (through_front < direct && through_front <= through_back) {
+            StepGapTo(0);
+            JumpGapToBack();
+        } else if (through_back < direct) {
+            StepGapTo(size_);
+            JumpGapToFront();
+        }
+        StepGapTo(index);
+    }
+
+    void StepGapTo(size_t index) {
+        while (gap_pos_ > index) {
+            // Элемент перед разрывом переходит за разрыв
+            Relocate(Wrap(front_ + gap_pos_ - 1), Wrap(front_ + gap_pos_ - 1 + GapSize()));
+            --gap_pos_;
+        }
+        while (gap_pos_ < index) {
+            // Элемент за разрывом переходит перед ним
+            Relocate(Wrap(front_ + gap_pos_ + GapSize()), Wrap(front_ + gap_pos_));
+            ++gap_pos_;
+        }
+    }
+
+    // Разрыв в начале и разрыв в конце занимают одни и те же ячейки: меняется только front_
+    void JumpGapToBack() noexcept {
+        front_ = Wrap(front_ + GapSize());
+        gap_pos_ = size_;
+    }
+
+    void JumpGapToFront() noexcept {
+        front_ = Wrap(front_ + size_);
+        gap_pos_ = 0;
+    }
+
+    // Удаляет первый элемент за разрывом, разрыв увеличивается на одну ячейку
+    void DestroyAfterGap() noexcept {
+        AllocatorTraits::destroy(data_.GetAllocator(), data_.Get() + SlotOf(gap_pos_));
+        --size_;
+    }
+
+    void EraseAt(size_t index) {
+        if (gap_pos_ == index + 1) {
+            // Элемент прямо перед разрывом присоединяется к разрыву без переносов
+            AllocatorTraits::destroy(data_.GetAllocator(), data_.Get() + SlotOf(index));
+            gap_pos_ = index;
+            --size_;
+            return;
+        }
+        MoveGap(index);
+        DestroyAfterGap();
+    }
+
+    // Переносит элементы в новую память вместимостью new_capacity, ставя разрыв перед gap_at.
+    // Если перенос бросит исключение, буфер не меняется
+    void Grow(size_t new_capacity, size_t gap_at) {
+        ArrayPtr<Type, Allocator> new_data(new_capacity, data_.GetAllocator());
+        const size_t new_gap = new_capacity - size_;
+        auto target = [&](size_t index) {
+            return new_data.Get() + index + (index >= gap_at ? new_gap : 0);
+        };
+        if constexpr (USE_BYTEWISE_RELOCATION) {
+            for (size_t i = 0; i < size_; ++i) {
+                std::memcpy(static_cast<void*>(target(i)), static_cast<const void*>(&(*this)[i]), sizeof(Type));
+            }
+        } else {
+            size_t moved = 0;
+            try {
+                for (; moved < size_; ++moved) {
+                    AllocatorTraits::construct(new_data.GetAllocator(), target(moved),
+                                               std::move_if_noexcept((*this)[moved]));
+                }
+            } catch (...) {
+                for (size_t i = 0; i < moved; ++i) {
+                    AllocatorTraits::destroy(new_data.GetAllocator(), target(i));
+                }
+                throw;
+            }
+            for (size_t i = 0; i < size_; ++i) {
+                AllocatorTraits::destroy(data_.GetAllocator(), &(*this)[i]);
+            }
+        }
+        data_.swap(new_data);
+        front_ = 0;
+        gap_pos_ = gap_at;
+    }
+
+    ArrayPtr<Type, Allocator> data_;
+    // Ячейка, где лежал бы элемент 0, если бы разрыва не было
+    size_t front_ = 0;
+    // Число элементов перед разрывом
+    size_t gap_pos_ = 0;
+    size_t size_ = 0;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// Политики роста SimpleVector.
+// Политика — тип со статическими функциями:
+//     NextCapacity(capacity, required, element_size) — новая вместимость, не меньше required;
+//     ShrinkCapacity(size, capacity) — вместимость после удаления элементов.
+//       Возврат capacity означает, что память не отдаётся.
+// SimpleVector вызывает ShrinkCapacity только если у политики AUTO_SHRINK == true.
+// Функции политики constexpr, чтобы SimpleVector работал при вычислении на этапе компиляции
+
+// Рост вдвое, для пустого вектора — до required. Память автоматически не отдаётся
+struct DoublingGrowth {
+    static constexpr bool AUTO_SHRINK = false;
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(required, capacity * 2);
+    }
+
+    static constexpr size_t ShrinkCapacity(size_t /*size*/, size_t capacity) noexcept {
+        return capacity;
+    }
+};
+
+// Рост в полтора раза: меньше пиковый перерасход памяти, но больше переносов элементов
+struct HalfGrowth {
+    static constexpr bool AUTO_SHRINK = false;
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(required, capacity + capacity / 2);
+    }
+
+    static constexpr size_t ShrinkCapacity(size_t /*size*/, size_t capacity) noexcept {
+        return capacity;
+    }
+};
+
+// Рост вдвое с округлением размера блока вверх: до PAGE_SIZE — до степени двойки
+// (классы размеров malloc), дальше — до целого числа страниц.
+// Так хвост блока, который аллокатор всё равно выделил бы, достаётся вектору
+struct SizeClassGrowth {
+    static constexpr bool AUTO_SHRINK = false;
+    static constexpr size_t MIN_BLOCK_SIZE = 16;
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t bytes = RoundBytes(std::max(required, capacity * 2) * element_size);
+        return std::max(required, bytes / element_size);
+    }
+
+    static constexpr size_t ShrinkCapacity(size_t /*size*/, size_t capacity) noexcept {
+        return capacity;
+    }
+
+    static constexpr size_t RoundBytes(size_t bytes) noexcept {
+        if (bytes >= PAGE_SIZE) {
+            return (bytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+        }
+        size_t block = MIN_BLOCK_SIZE;
+        while (block < bytes) {
+            block *= 2;
+        }
+        return block;
+    }
+};
+
+// Добавляет к политике Base автоматическое уменьшение вместимости с гистерезисом:
+// память отдаётся, когда заполнено не больше 1/SHRINK_DIVISOR вместимости,
+// и вместимость сокращается до 2 * size, чтобы повторный рост не начинался сразу же.
+// Векторы меньше MIN_CAPACITY элементов не сжимаются
+template <typename Base = DoublingGrowth, size_t ShrinkDivisor = 4, size_t MinCapacity = 16>
+struct HysteresisShrink {
+    static_assert(ShrinkDivisor > 2, "shrinking to 2 * size needs a divisor above 2");
+
+    static constexpr bool AUTO_SHRINK = true;
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        return Base::NextCapacity(capacity, required, element_size);
+    }
+
+    static constexpr size_t ShrinkCapacity(size_t size, size_t capacity) noexcept {
+        if (capacity <= MinCapacity || size > capacity / ShrinkDivisor) {
+            return capacity;
+        }
+        return std::max(size * 2, MinCapacity);
+    }
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Итератор с произвольным доступом по контейнеру с operator[]: хранит контейнер и номер
+// элемента, разыменование — (*container)[index]. Подходит контейнерам с несплошной памятью
+// (SegmentedVector, GapBuffer). Value — тип элемента, const Value для константного итератора.
+// Итератор не портится, пока элемент с его номером существует, даже если память контейнера
+// перестроена
+template <typename Container, typename Value>
+class IndexIterator {
+    using Owner = std::conditional_t<std::is_const_v<Value>, const Container, Container>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Value>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Value*;
+    using reference = Value&;
+
+    IndexIterator() noexcept = default;
+
+    IndexIterator(Owner* owner, size_t index) noexcept
+    : owner_(owner), index_(index) {
+    }
+
+    // Итератор на изменяемые элементы приводится к итератору на константные
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Value> &&
+                                                          !std::is_same_v<Other, Value>>>
+    IndexIterator(const IndexIterator<Container, Other>& other) noexcept
+    : owner_(other.owner_), index_(other.index_) {
+    }
+
+    reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+
+    pointer operator->() const noexcept {
+        return &(*owner_)[index_];
+    }
+
+    reference operator[](difference_type n) const noexcept {
+        return (*owner_)[index_ + n];
+    }
+
+    IndexIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    IndexIterator operator++(int) noexcept {
+        IndexIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    IndexIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    IndexIterator operator--(int) noexcept {
+        IndexIterator old = *this;
+        --index_;
+        return old;
+    }
+
+    IndexIterator& operator+=(difference_type n) noexcept {
+        index_ += n;
+        return *this;
+    }
+
+    IndexIterator& operator-=(difference_type n) noexcept {
+        index_ -= n;
+        return *this;
+    }
+
+    friend IndexIterator operator+(IndexIterator it, difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend IndexIterator operator+(difference_type n, IndexIterator it) noexcept {
+        return it += n;
+    }
+
+    friend IndexIterator operator-(IndexIterator it, difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const IndexIterator& lhs, const IndexIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    template <typename, typename>
+    friend class IndexIterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
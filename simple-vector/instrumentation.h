@@ -0,0 +1,330 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+// Политики инструментирования SimpleVector: четвёртый параметр шаблона.
+// Политика предоставляет статические шаблонные функции, которые вектор вызывает
+// при работе с памятью (Type — тип элементов вектора):
+//     OnAllocate<Type>(capacity)       — выделен буфер на capacity элементов;
+//     OnRelease<Type>(size, capacity)  — освобождается буфер, в котором было size элементов;
+//     OnGrowth<Type>(source, old_capacity, new_capacity, in_place) — вместимость изменилась
+//         по причине source; in_place — блок расширен аллокатором без переноса;
+//     OnRelocate<Type>(count)          — count элементов перенесено в новый буфер;
+//     OnSize<Type>(size, capacity)     — размер вырос до size.
+// NoInstrumentation (по умолчанию) ничего не делает: вызовы встраиваются в пустоту,
+// и вектор не отличается от неинструментированного ни размером, ни кодом
+
+// Операция, из-за которой изменилась вместимость
+enum class GrowthSource {
+    RESERVE,
+    RESIZE,
+    PUSH_BACK,
+    INSERT,
+    SHRINK,
+};
+
+inline constexpr size_t GROWTH_SOURCE_COUNT = 5;
+
+inline const char* GrowthSourceName(GrowthSource source) noexcept {
+    switch (source) {
+    case GrowthSource::RESERVE:
+        return "reserve";
+    case GrowthSource::RESIZE:
+        return "resize";
+    case GrowthSource::PUSH_BACK:
+        return "push_back";
+    case GrowthSource::INSERT:
+        return "insert";
+    case GrowthSource::SHRINK:
+        return "shrink";
+    }
+    return "unknown";
+}
+
+struct NoInstrumentation {
+    template <typename Type>
+    static void OnAllocate(size_t) noexcept {
+    }
+
+    template <typename Type>
+    static void OnRelease(size_t, size_t) noexcept {
+    }
+
+    template <typename Type>
+    static void OnGrowth(GrowthSource, size_t, size_t, bool) noexcept {
+    }
+
+    template <typename Type>
+    static void OnRelocate(size_t) noexcept {
+    }
+
+    template <typename Type>
+    static void OnSize(size_t, size_t) noexcept {
+    }
+};
+
+// Накопленная статистика всех векторов с элементами одного типа
+struct VectorStats {
+    std::string type_name;
+    size_t element_size = 0;
+    size_t allocations = 0;
+    size_t releases = 0;
+    size_t bytes_allocated = 0;
+    // Байты, перенесённые в новые буферы при росте и сжатии
+    size_t bytes_relocated = 0;
+    // Изменения вместимости по операциям, включая расширения на месте
+    size_t growth_events[GROWTH_SOURCE_COUNT] = {};
+    size_t in_place_growths = 0;
+    // Наибольшие размер и вместимость, встреченные у одного вектора
+    size_t max_size = 0;
+    size_t max_capacity = 0;
+    // Сумма (capacity - size) * sizeof(Type) на момент освобождения буферов:
+    // сколько зарезервированной памяти так и не понадобилось
+    size_t unused_bytes_at_release = 0;
+
+    size_t GetGrowthEvents(GrowthSource source) const noexcept {
+        return growth_events[static_cast<size_t>(source)];
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& out, const VectorStats& stats) {
+    out << stats.type_name << ": element_size=" << stats.element_size << " allocations=" << stats.allocations
+        << " releases=" << stats.releases << " bytes_allocated=" << stats.bytes_allocated
+        << " bytes_relocated=" << stats.bytes_relocated << " growth{";
+    for (size_t i = 0; i < GROWTH_SOURCE_COUNT; ++i) {
+        out << (i == 0 ? "" : " ") << GrowthSourceName(static_cast<GrowthSource>(i)) << '='
+            << stats.growth_events[i];
+    }
+    return out << "} in_place_growths=" << stats.in_place_growths << " max_size=" << stats.max_size
+               << " max_capacity=" << stats.max_capacity
+               << " unused_bytes_at_release=" << stats.unused_bytes_at_release;
+}
+
+// Считает события отдельно для каждого типа элементов. Счётчики атомарные,
+// поэтому векторы можно использовать из разных потоков.
+// Статистику можно получить для одного типа (GetStats<Type>), обойти по всем типам
+// (ForEach) или напечатать (Dump). SetGrowthCallback подписывает на каждое изменение
+// вместимости — например, чтобы найти места, где стоит вызвать Reserve заранее.
+// Обработчики событий не бросают исключений: они вызываются из кода вектора, который
+// работает с памятью. Если при первом событии типа не хватило памяти на его запись,
+// события этого типа учитываются в общей записи UNREGISTERED_TYPE_NAME
+class CountingInstrumentation {
+public:
+    using GrowthCallback = void (*)(const char* type_name, GrowthSource source, size_t old_capacity,
+                                    size_t new_capacity);
+
+    static constexpr const char* UNREGISTERED_TYPE_NAME = "<unregistered>";
+
+    template <typename Type>
+    static void OnAllocate(size_t capacity) noexcept {
+        Entry& entry = EntryFor<Type>();
+        entry.allocations.fetch_add(1, std::memory_order_relaxed);
+        entry.bytes_allocated.fetch_add(capacity * sizeof(Type), std::memory_order_relaxed);
+        UpdateMax(entry.max_capacity, capacity);
+    }
+
+    template <typename Type>
+    static void OnRelease(size_t size, size_t capacity) noexcept {
+        Entry& entry = EntryFor<Type>();
+        entry.releases.fetch_add(1, std::memory_order_relaxed);
+        entry.unused_bytes_at_release.fetch_add((capacity - size) * sizeof(Type), std::memory_order_relaxed);
+    }
+
+    template <typename Type>
+    static void OnGrowth(GrowthSource source, size_t old_capacity, size_t new_capacity, bool in_place) noexcept {
+        Entry& entry = EntryFor<Type>();
+        entry.growth_events[static_cast<size_t>(source)].fetch_add(1, std::memory_order_relaxed);
+        if (in_place) {
+            entry.in_place_growths.fetch_add(1, std::memory_order_relaxed);
+            UpdateMax(entry.max_capacity, new_capacity);
+        }
+        if (const GrowthCallback callback = GrowthCallbackStorage().load(std::memory_order_acquire)) {
+            callback(entry.GetName(), source, old_capacity, new_capacity);
+        }
+    }
+
+    template <typename Type>
+    static void OnRelocate(size_t count) noexcept {
+        EntryFor<Type>().bytes_relocated.fetch_add(count * sizeof(Type), std::memory_order_relaxed);
+    }
+
+    template <typename Type>
+    static void OnSize(size_t size, size_t) noexcept {
+        UpdateMax(EntryFor<Type>().max_size, size);
+    }
+
+    template <typename Type>
+    static VectorStats GetStats() {
+        return EntryFor<Type>().Snapshot();
+    }
+
+    // Вызывает callback для каждого типа, у которого были события
+    static void ForEach(const std::function<void(const VectorStats&)>& callback) {
+        std::vector<VectorStats> snapshots;
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            for (const Entry* entry : registry.entries) {
+                snapshots.push_back(entry->Snapshot());
+            }
+            if (registry.fallback_used.load(std::memory_order_relaxed)) {
+                snapshots.push_back(registry.fallback.Snapshot());
+            }
+        }
+        for (const VectorStats& stats : snapshots) {
+            callback(stats);
+        }
+    }
+
+    // Печатает статистику всех типов, по строке на тип
+    static void Dump(std::ostream& out) {
+        ForEach([&out](const VectorStats& stats) {
+            out << stats << '\n';
+        });
+    }
+
+    // Обнуляет счётчики всех типов
+    static void Reset() {
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex);
+        for (Entry* entry : registry.entries) {
+            entry->Reset();
+        }
+        registry.fallback.Reset();
+    }
+
+    // Задаёт функцию, вызываемую при каждом изменении вместимости. nullptr отключает вызовы.
+    // Функция вызывается из потока, изменившего вектор, внутри noexcept-обработчика,
+    // поэтому не должна бросать исключений: исключение из неё вызовет std::terminate
+    static void SetGrowthCallback(GrowthCallback callback) noexcept {
+        GrowthCallbackStorage().store(callback, std::memory_order_release);
+    }
+
+private:
+    struct Entry {
+        // Пустое имя — общая запись для типов, которые не удалось зарегистрировать
+        Entry(std::string name, size_t size) noexcept
+        : type_name(std::move(name)), element_size(size) {
+        }
+
+        const char* GetName() const noexcept {
+            return type_name.empty() ? UNREGISTERED_TYPE_NAME : type_name.c_str();
+        }
+
+        VectorStats Snapshot() const {
+            VectorStats stats;
+            stats.type_name = GetName();
+            stats.element_size = element_size;
+            stats.allocations = allocations.load(std::memory_order_relaxed);
+            stats.releases = releases.load(std::memory_order_relaxed);
+            stats.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+            stats.bytes_relocated = bytes_relocated.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < GROWTH_SOURCE_COUNT; ++i) {
+                stats.growth_events[i] = growth_events[i].load(std::memory_order_relaxed);
+            }
+            stats.in_place_growths = in_place_growths.load(std::memory_order_relaxed);
+            stats.max_size = max_size.load(std::memory_order_relaxed);
+            stats.max_capacity = max_capacity.load(std::memory_order_relaxed);
+            stats.unused_bytes_at_release = unused_bytes_at_release.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        void Reset() noexcept {
+            for (std::atomic<size_t>* counter : {&allocations, &releases, &bytes_allocated, &bytes_relocated,
+                                                 &in_place_growths, &max_size, &max_capacity,
+                                                 &unused_bytes_at_release}) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (std::atomic<size_t>& counter : growth_events) {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        const std::string type_name;
+        const size_t element_size;
+        std::atomic<size_t> allocations{0};
+        std::atomic<size_t> releases{0};
+        std::atomic<size_t> bytes_allocated{0};
+        std::atomic<size_t> bytes_relocated{0};
+        std::atomic<size_t> growth_events[GROWTH_SOURCE_COUNT] = {};
+        std::atomic<size_t> in_place_growths{0};
+        std::atomic<size_t> max_size{0};
+        std::atomic<size_t> max_capacity{0};
+        std::atomic<size_t> unused_bytes_at_release{0};
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<Entry*> entries;
+        // Создаётся без выделения памяти, поэтому доступна всегда
+        Entry fallback{std::string(), 0};
+        std::atomic<bool> fallback_used{false};
+    };
+
+    static Registry& GetRegistry() noexcept {
+        static Registry registry;
+        return registry;
+    }
+
+    static std::atomic<GrowthCallback>& GrowthCallbackStorage() noexcept {
+        static std::atomic<GrowthCallback> callback{nullptr};
+        return callback;
+    }
+
+    // Запись типа создаётся и регистрируется при первом событии
+    template <typename Type>
+    static Entry& EntryFor() noexcept {
+        static Entry& entry = RegisterEntry<Type>();
+        return entry;
+    }
+
+    // Имя типа и место в реестре требуют памяти. Если её не хватило, тип навсегда
+    // получает общую запись: обработчик события не может ни бросить, ни потерять событие
+    template <typename Type>
+    static Entry& RegisterEntry() noexcept {
+        Registry& registry = GetRegistry();
+        try {
+            static Entry entry(TypeName<Type>(), sizeof(Type));
+            std::lock_guard<std::mutex> guard(registry.mutex);
+            registry.entries.push_back(&entry);
+            return entry;
+        } catch (...) {
+            registry.fallback_used.store(true, std::memory_order_relaxed);
+            return registry.fallback;
+        }
+    }
+
+    template <typename Type>
+    static std::string TypeName() {
+        const char* name = typeid(Type).name();
+#ifdef __GNUG__
+        int status = 0;
+        const std::unique_ptr<char, void (*)(void*)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status),
+                                                               std::free);
+        if (status == 0 && demangled) {
+            return demangled.get();
+        }
+#endif
+        return name;
+    }
+
+    static void UpdateMax(std::atomic<size_t>& max, size_t value) noexcept {
+        size_t current = max.load(std::memory_order_relaxed);
+        while (current < value && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+};
@@ -1,42 +1,46 @@
+#include "allocators.h"
+#include "concurrent_simple_vector.h"
+#include "cow_simple_vector.h"
+#include "file_backed_vector.h"
+#include "flat_map.h"
+#include "flat_set.h"
+#include "gap_buffer.h"
+#include "mmap_allocator.h"
+#include "packed_vector.h"
+#include "parallel.h"
+#include "pipeline.h"
+#include "prefetch_iterator.h"
+#include "segmented_vector.h"
 #include "simple_vector.h"
+#include "small_simple_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
+#include "test_types.h"
+#include "vector_io.h"
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
 #include <numeric>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
-using namespace std;
+#include <csignal>
 
-class X {
-public:
-    X()
-        : X(5) {
-    }
-    X(size_t num)
-        : x_(num) {
-    }
-    X(const X& other) = delete;
-    X& operator=(const X& other) = delete;
-    X(X&& other) {
-        x_ = exchange(other.x_, 0);
-    }
-    X& operator=(X&& other) {
-        x_ = exchange(other.x_, 0);
-        return *this;
-    }
-    size_t GetX() const {
-        return x_;
-    }
-
-private:
-    size_t x_;
-};
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
-SimpleVector<int> GenerateVector(size_t size) {
-    SimpleVector<int> v(size);
-    iota(v.begin(), v.end(), 1);
-    return v;
-}
+using namespace std;
 
 void TestTemporaryObjConstructor() {
     const size_t size = 1000000;
@@ -150,6 +154,2133 @@ void TestNoncopiableErase() {
     cout << "Done!"s << endl << endl;
 }
 
+void TestUninitializedStorage() {
+    cout << "Test uninitialized storage"s << endl;
+    {
+        SimpleVector<Counted> v(Reserve(100));
+        assert(v.GetCapacity() == 100);
+        assert(Counted::alive == 0);
+
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(Counted(i));
+        }
+        assert(Counted::alive == 10);
+        v.Reserve(1000);
+        assert(Counted::alive == 10);
+        assert(v[9].GetValue() == 9);
+
+        v.PopBack();
+        assert(Counted::alive == 9);
+        v.Erase(v.begin());
+        assert(Counted::alive == 8);
+        assert(v[0].GetValue() == 1);
+        v.Insert(v.begin() + 2, Counted(42));
+        assert(Counted::alive == 9);
+        assert(v[2].GetValue() == 42);
+
+        SimpleVector<Counted> copy(v);
+        assert(Counted::alive == 18);
+        copy.Clear();
+        assert(Counted::alive == 9);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestEmplace() {
+    cout << "Test emplace"s << endl;
+    SimpleVector<X> v;
+    X& back = v.EmplaceBack(7);
+    assert(back.GetX() == 7);
+    v.EmplaceBack();
+    assert(v[1].GetX() == 5);
+
+    auto it = v.Emplace(v.begin(), 1);
+    assert(it == v.begin());
+    it = v.Emplace(v.begin() + 2, 3);
+    assert(v.GetSize() == 4);
+    assert(it->GetX() == 3);
+    assert(v[0].GetX() == 1 && v[1].GetX() == 7 && v[2].GetX() == 3 && v[3].GetX() == 5);
+
+    // Аргумент, ссылающийся на элемент самого вектора
+    SimpleVector<string> s{"a"s, "b"s};
+    s.PushBack(s[0]);
+    s.Insert(s.begin(), s[1]);
+    assert((s == SimpleVector<string>{"b"s, "a"s, "b"s, "a"s}));
+
+    // PushBack временного объекта — одно перемещение, EmplaceBack и Emplace в конец создают
+    // элемент на месте без копирований и перемещений
+    const size_t count = 1000;
+    auto count_appends = [count](auto append) {
+        SimpleVector<Tracked> tracked(Reserve(count));
+        Tracked::counters = TrackedCounters{};
+        for (size_t i = 0; i < count; ++i) {
+            append(tracked, static_cast<int>(i));
+        }
+        assert(tracked.GetSize() == count && tracked[count - 1].value == static_cast<int>(count));
+        return Tracked::counters;
+    };
+    const TrackedCounters push_back = count_appends([](auto& tracked, int i) {
+        tracked.PushBack(Tracked(i, 1));
+    });
+    assert(push_back.constructions == count && push_back.moves == count && push_back.copies == 0);
+    const TrackedCounters emplace_back = count_appends([](auto& tracked, int i) {
+        tracked.EmplaceBack(i, 1);
+    });
+    assert(emplace_back.constructions == count && emplace_back.moves == 0 && emplace_back.copies == 0);
+    const TrackedCounters emplace_end = count_appends([](auto& tracked, int i) {
+        tracked.Emplace(tracked.end(), i, 1);
+    });
+    assert(emplace_end.constructions == count && emplace_end.moves == 0 && emplace_end.copies == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestAllocators() {
+    cout << "Test arena and pool allocators"s << endl;
+    {
+        MonotonicArena arena(1024);
+        ArenaAllocator<string> alloc(arena);
+        SimpleVector<string, ArenaAllocator<string>> v(alloc);
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(to_string(i));
+        }
+        assert(v.GetSize() == 100 && v[99] == "99"s);
+        assert(arena.GetBytesAllocated() >= v.GetCapacity() * sizeof(string));
+
+        auto copy = v;
+        assert(copy == v && copy.GetAllocator() == alloc);
+        copy.Clear();
+        v.Clear();
+        arena.Release();
+        assert(arena.GetBytesAllocated() == 0);
+    }
+    {
+        FixedSizePool pool;
+        PoolAllocator<int> alloc(pool);
+        SimpleVector<int, PoolAllocator<int>> v(alloc);
+        for (int i = 0; i < 10000; ++i) {
+            v.PushBack(i);
+        }
+        SimpleVector<int, PoolAllocator<int>> small({1, 2, 3}, alloc);
+        small.Reserve(4);
+        assert(v[9999] == 9999 && small.GetCapacity() == 4);
+        assert((small == SimpleVector<int, PoolAllocator<int>>({1, 2, 3}, alloc)));
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestTriviallyRelocatable() {
+    cout << "Test trivially relocatable types"s << endl;
+    static_assert(IsTriviallyRelocatableV<int>);
+    static_assert(!IsTriviallyRelocatableV<string>);
+    {
+        SimpleVector<int> v{1, 2, 3, 4, 5};
+        v.Insert(v.begin() + 2, 10);
+        v.Insert(v.begin(), v[5]);
+        assert((v == SimpleVector<int>{5, 1, 2, 10, 3, 4, 5}));
+        v.Erase(v.begin() + 3);
+        v.Erase(v.end() - 1);
+        assert((v == SimpleVector<int>{5, 1, 2, 3, 4}));
+        SimpleVector<int> copy(v);
+        assert(copy == v);
+    }
+    {
+        SimpleVector<OwnedInt> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Emplace(v.begin() + 5, 100);
+        v.Erase(v.begin());
+        assert(v.GetSize() == 10 && *v[0].ptr == 1 && *v[4].ptr == 100 && *v[9].ptr == 9);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSmallSimpleVector() {
+    cout << "Test small simple vector"s << endl;
+    {
+        SmallSimpleVector<X, 4> v;
+        assert(v.GetCapacity() == 4 && v.IsInline());
+        for (size_t i = 0; i < 4; ++i) {
+            v.PushBack(X(i));
+        }
+        assert(v.IsInline());
+        v.Insert(v.begin(), X(10));
+        assert(!v.IsInline() && v.GetCapacity() == 8 && v.GetSize() == 5);
+        assert(v[0].GetX() == 10 && v[4].GetX() == 3);
+        v.Erase(v.begin() + 1);
+        assert(v[1].GetX() == 1);
+
+        SmallSimpleVector<X, 4> moved(move(v));
+        assert(moved.GetSize() == 4 && v.GetSize() == 0 && v.IsInline());
+
+        SmallSimpleVector<X, 4> inline_src;
+        inline_src.EmplaceBack(1);
+        inline_src.EmplaceBack(2);
+        SmallSimpleVector<X, 4> inline_moved(move(inline_src));
+        assert(inline_moved.IsInline() && inline_moved[1].GetX() == 2 && inline_src.IsEmpty());
+        inline_moved.swap(moved);
+        assert(moved.GetSize() == 2 && inline_moved.GetSize() == 4);
+    }
+    {
+        SmallSimpleVector<string, 2> v{"a"s, "b"s, "c"s};
+        auto copy = v;
+        assert(copy == v);
+        v.Resize(1);
+        assert(v < copy);
+        v.Resize(5);
+        assert(v.GetSize() == 5 && v[4].empty());
+    }
+    {
+        SmallSimpleVector<Counted, 3> v;
+        v.EmplaceBack(1);
+        v.EmplaceBack(2);
+        v.Reserve(10);
+        v.PopBack();
+        assert(Counted::alive == 1);
+    }
+    assert(Counted::alive == 0);
+    {
+        // Пока элементы помещаются во встроенный буфер, куча не используется
+        const size_t vectors = 1000;
+        auto count_allocations = [vectors](auto make_vector) {
+            CountingAllocator<int>::allocations = 0;
+            for (size_t i = 0; i < vectors; ++i) {
+                auto v = make_vector();
+                for (size_t j = 0; j <= i % 8; ++j) {
+                    v.PushBack(static_cast<int>(j));
+                }
+                assert(v.GetSize() == i % 8 + 1);
+            }
+            return CountingAllocator<int>::allocations;
+        };
+        const size_t simple = count_allocations([] {
+            return SimpleVector<int, CountingAllocator<int>>();
+        });
+        const size_t small = count_allocations([] {
+            return SmallSimpleVector<int, 8, CountingAllocator<int>>();
+        });
+        assert(small == 0 && simple > vectors);
+
+        SmallSimpleVector<int, 8, CountingAllocator<int>> v(8);
+        v.PushBack(9);
+        assert(CountingAllocator<int>::allocations == 1 && !v.IsInline());
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+// Тип, копирование которого бросает исключение после заданного числа копий.
+// Relocatable задаёт, переносит ли вектор его побайтово
+template <bool Relocatable>
+struct ThrowingCopy {
+    explicit ThrowingCopy(int v)
+        : value(v) {
+        ++alive;
+    }
+    ThrowingCopy(const ThrowingCopy& other)
+        : value(other.value) {
+        if (copies_before_throw == 0) {
+            throw runtime_error("copy failed"s);
+        }
+        --copies_before_throw;
+        ++alive;
+    }
+    ThrowingCopy(ThrowingCopy&& other) noexcept
+        : value(other.value) {
+        ++alive;
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+    ~ThrowingCopy() {
+        --alive;
+    }
+
+    int value;
+    inline static int alive = 0;
+    inline static size_t copies_before_throw = numeric_limits<size_t>::max();
+};
+
+template <bool Relocatable>
+struct IsTriviallyRelocatable<ThrowingCopy<Relocatable>> : std::bool_constant<Relocatable> {
+};
+
+template <bool Relocatable>
+void CheckRangeInsertRollback() {
+    using Value = ThrowingCopy<Relocatable>;
+    vector<Value> source;
+    for (int i = 0; i < 5; ++i) {
+        source.emplace_back(100 + i);
+    }
+    for (size_t capacity : {size_t{4}, size_t{32}}) {
+        SimpleVector<Value> v(Reserve(capacity));
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        const int alive = Value::alive;
+        Value::copies_before_throw = 2;
+        try {
+            v.Insert(v.begin() + 1, source.begin(), source.end());
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        Value::copies_before_throw = numeric_limits<size_t>::max();
+        assert(Value::alive == alive && v.GetSize() == 4 && v.GetCapacity() == capacity);
+        for (int i = 0; i < 4; ++i) {
+            assert(v[i].value == i);
+        }
+    }
+}
+
+void TestBatchInsert() {
+    cout << "Test batch insert"s << endl;
+    {
+        const vector<int> source{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        SimpleVector<int, CountingAllocator<int>> v;
+        CountingAllocator<int>::allocations = 0;
+        v.Append(source.begin(), source.end());
+        assert(CountingAllocator<int>::allocations == 1 && v.GetSize() == 10);
+        v.Append({11, 12});
+        assert(v.GetSize() == 12 && v[11] == 12);
+
+        v.Reserve(100);
+        CountingAllocator<int>::allocations = 0;
+        auto it = v.Insert(v.begin() + 2, source.begin(), source.begin() + 3);
+        assert(it == v.begin() + 2 && CountingAllocator<int>::allocations == 0);
+        const vector<int> expected{1, 2, 1, 2, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+        assert(equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+        v.Erase(v.begin() + 2, v.begin() + 5);
+        assert(v.GetSize() == 12 && v[2] == 3 && v[11] == 12);
+        const auto erased = v.Erase(v.begin() + 3, v.begin() + 3);
+        assert(erased == v.begin() + 3 && v.GetSize() == 12);
+    }
+    {
+        // Значение и диапазон из самого вектора: с запасом вместимости и с перевыделением
+        for (size_t capacity : {size_t{0}, size_t{64}}) {
+            SimpleVector<int> v{1, 2, 3};
+            v.Reserve(capacity);
+            v.Insert(v.begin(), 2, v[2]);
+            assert((v == SimpleVector<int>{3, 3, 1, 2, 3}));
+            v.Insert(v.begin() + 1, v.begin() + 2, v.end());
+            assert((v == SimpleVector<int>{3, 1, 2, 3, 3, 1, 2, 3}));
+
+            SimpleVector<string> s{"a"s, "b"s};
+            s.Reserve(capacity);
+            s.Insert(s.end(), 2, s[0]);
+            s.Insert(s.begin(), s.begin(), s.end());
+            assert((s == SimpleVector<string>{"a"s, "b"s, "a"s, "a"s, "a"s, "b"s, "a"s, "a"s}));
+        }
+    }
+    {
+        // Однопроходные итераторы
+        istringstream input("4 5 6"s);
+        SimpleVector<int> v{1, 2, 3};
+        v.Insert(v.begin() + 1, istream_iterator<int>(input), istream_iterator<int>());
+        assert((v == SimpleVector<int>{1, 4, 5, 6, 2, 3}));
+        istringstream tail("7 8"s);
+        v.Append(istream_iterator<int>(tail), istream_iterator<int>());
+        assert((v == SimpleVector<int>{1, 4, 5, 6, 2, 3, 7, 8}));
+    }
+    {
+        SimpleVector<Counted> v;
+        const vector<Counted> source{Counted(1), Counted(2), Counted(3), Counted(4)};
+        v.Append(source.begin(), source.end());
+        v.Insert(v.begin(), source.begin(), source.end());
+        v.Erase(v.begin() + 1, v.begin() + 7);
+        assert(v.GetSize() == 2 && v[0].GetValue() == 1 && v[1].GetValue() == 4);
+        assert(Counted::alive == 6);
+    }
+    assert(Counted::alive == 0);
+    {
+        SimpleVector<int> v{1, 2};
+        v.Insert(v.begin() + 1, size_t{3}, 7);
+        assert((v == SimpleVector<int>{1, 7, 7, 7, 2}));
+        v.Insert(v.end(), {8, 9});
+        assert(v.GetSize() == 7 && v[6] == 9);
+    }
+    CheckRangeInsertRollback<false>();
+    CheckRangeInsertRollback<true>();
+    assert(ThrowingCopy<false>::alive == 0 && ThrowingCopy<true>::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestGrowthPolicies() {
+    cout << "Test growth policies and shrink to fit"s << endl;
+    {
+        SimpleVector<int> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.GetCapacity() == 8);
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 5 && v[4] == 4);
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.GetCapacity() == 0 && v.GetData() == nullptr);
+    }
+    {
+        SimpleVector<int, allocator<int>, HalfGrowth> v;
+        v.Resize(10);
+        v.PushBack(1);
+        assert(v.GetCapacity() == 15);
+    }
+    {
+        SimpleVector<char, allocator<char>, SizeClassGrowth> v;
+        v.PushBack('a');
+        assert(v.GetCapacity() == 16);
+        v.Resize(3000);
+        assert(v.GetCapacity() == 4096);
+        v.Resize(5000);
+        assert(v.GetCapacity() == 8192);
+    }
+    {
+        SimpleVector<string, allocator<string>, HysteresisShrink<>> v(1000, "x"s);
+        assert(v.GetCapacity() == 1000);
+        v.Resize(300);
+        assert(v.GetCapacity() == 1000);
+        v.Resize(250);
+        assert(v.GetCapacity() == 500 && v[249] == "x"s);
+        while (!v.IsEmpty()) {
+            v.Erase(v.begin());
+        }
+        assert(v.GetCapacity() == 16);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestMmapAllocator() {
+    cout << "Test mmap allocator"s << endl;
+    MmapAllocator<int> alloc(size_t{1} << 30);
+    SimpleVector<int, MmapAllocator<int>> v(alloc);
+    v.PushBack(0);
+    const int* address = v.GetData();
+    for (int i = 1; i < 1000000; ++i) {
+        v.PushBack(i);
+    }
+    assert(v.GetData() == address);
+    assert(v[999999] == 999999);
+    // Резерв в 1 ГиБ вмещает 2^28 элементов int
+    v.Reserve(size_t{1} << 28);
+    assert(v.GetData() == address && v.GetCapacity() == size_t{1} << 28);
+    // Рост за пределы резерва переносит элементы в новый диапазон
+    v.Reserve((size_t{1} << 28) + 1);
+    assert(v.GetData() != address && v[999999] == 999999);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestFileBackedVector() {
+    cout << "Test file backed vector"s << endl;
+    struct Point {
+        int x;
+        double y;
+    };
+    const string path = "/tmp/simple_vector_file_backed_test_"s + to_string(getpid());
+    {
+        FileBackedVector<Point> v(path);
+        assert(v.IsEmpty());
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack({i, i * 0.5});
+        }
+        v.EmplaceBack(Point{-1, -1.0});
+        v.Erase(v.begin());
+        v.Sync();
+    }
+    {
+        FileBackedVector<Point> v(path);
+        assert(v.GetSize() == 1000 && v.GetCapacity() == 1024);
+        assert(v[0].x == 1 && v[998].y == 499.5 && v[999].x == -1);
+        v.Resize(10);
+        v.PushBack({42, 0.0});
+    }
+    {
+        FileBackedVector<Point> v(path);
+        assert(v.GetSize() == 11 && v[10].x == 42);
+    }
+    {
+        // Перемещённый вектор пуст
+        FileBackedVector<Point> v(path);
+        FileBackedVector<Point> moved = std::move(v);
+        assert(v.GetSize() == 0 && v.GetCapacity() == 0 && v.IsEmpty());
+        v.Clear();
+        v.PopBack();
+        assert(moved.GetSize() == 11);
+    }
+    {
+        // Вместимость в заголовке, при которой размер файла переполняет size_t
+        const uint64_t capacity = uint64_t{1} << 60;
+        const int fd = open(path.c_str(), O_WRONLY);
+        const ssize_t written = pwrite(fd, &capacity, sizeof(capacity), offsetof(FileBackedHeader, capacity));
+        close(fd);
+        assert(written == sizeof(capacity));
+        try {
+            FileBackedVector<Point> corrupted(path);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+    }
+    try {
+        FileBackedVector<int> wrong(path);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    remove(path.c_str());
+    cout << "Done!"s << endl << endl;
+}
+
+void TestVectorIo() {
+    cout << "Test vector I/O"s << endl;
+    const string path = "/tmp/simple_vector_io_test_"s + to_string(getpid());
+    auto open_for_write = [&path] {
+        return open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    };
+    {
+        SimpleVector<int> v = GenerateVector(100000);
+        int fd = open_for_write();
+        WriteTo(fd, v);
+        close(fd);
+
+        SimpleVector<int> read{1, 2, 3};
+        fd = open(path.c_str(), O_RDONLY);
+        ReadFrom(fd, read);
+        close(fd);
+        assert(read == v);
+
+        fd = open(path.c_str(), O_RDONLY);
+        VectorStreamReader<int> reader(fd);
+        SimpleVector<int> chunked;
+        size_t chunks = 0;
+        while (reader.ReadChunk(chunked, 30000) != 0) {
+            ++chunks;
+            // Память растёт по мере чтения, а не сразу под весь поток
+            assert(chunked.GetCapacity() < 2 * chunked.GetSize() + 1);
+        }
+        close(fd);
+        assert(chunks == 4 && chunked == v);
+    }
+    {
+        // Поток больше одного шага чтения VECTOR_STREAM_PIECE_BYTES
+        const size_t size = VECTOR_STREAM_PIECE_BYTES / sizeof(int) + 1000;
+        SimpleVector<int> v = GenerateVector(size);
+        int fd = open_for_write();
+        WriteTo(fd, v);
+        close(fd);
+
+        SimpleVector<int> read;
+        fd = open(path.c_str(), O_RDONLY);
+        ReadFrom(fd, read);
+        close(fd);
+        assert(read.GetSize() == size && read == v);
+    }
+    {
+        SimpleVector<string> v{""s, "a"s, string(100000, 'x'), "hello"s};
+        int fd = open_for_write();
+        WriteTo(fd, v);
+        close(fd);
+
+        SimpleVector<string> read;
+        fd = open(path.c_str(), O_RDONLY);
+        ReadFrom(fd, read);
+        close(fd);
+        assert(read == v);
+
+        SimpleVector<int> wrong;
+        fd = open(path.c_str(), O_RDONLY);
+        try {
+            ReadFrom(fd, wrong);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        close(fd);
+    }
+    {
+        // Оборванный поток: вектор возвращается к прежнему размеру, остаток потока не меняется
+        auto cut_tail = [&path](off_t bytes) {
+            struct stat info {};
+            const int stat_result = stat(path.c_str(), &info);
+            const int truncate_result = truncate(path.c_str(), info.st_size - bytes);
+            assert(stat_result == 0 && truncate_result == 0);
+        };
+        SimpleVector<int> v = GenerateVector(50000);
+        int fd = open_for_write();
+        WriteTo(fd, v);
+        close(fd);
+        cut_tail(1000);
+
+        SimpleVector<int> read{1, 2, 3};
+        fd = open(path.c_str(), O_RDONLY);
+        try {
+            ReadFrom(fd, read);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        close(fd);
+        assert((read == SimpleVector<int>{1, 2, 3}));
+
+        fd = open(path.c_str(), O_RDONLY);
+        VectorStreamReader<int> reader(fd);
+        SimpleVector<int> chunked;
+        assert(reader.ReadChunk(chunked, 30000) == 30000);
+        try {
+            reader.ReadChunk(chunked, 30000);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        close(fd);
+        assert(chunked.GetSize() == 30000 && reader.GetRemaining() == 20000 && chunked[29999] == 30000);
+
+        SimpleVector<string> words{"alpha"s, "beta"s, string(1000, 'g')};
+        fd = open_for_write();
+        WriteTo(fd, words);
+        close(fd);
+        cut_tail(10);
+        SimpleVector<string> read_words{"x"s};
+        fd = open(path.c_str(), O_RDONLY);
+        VectorStreamReader<string> word_reader(fd);
+        try {
+            word_reader.ReadChunk(read_words, 10);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        close(fd);
+        assert((read_words == SimpleVector<string>{"x"s}) && word_reader.GetRemaining() == 3);
+    }
+    {
+        // Заголовок обещает 2^40 элементов, а данных почти нет: ошибка чтения, а не попытка
+        // выделить терабайты
+        VectorStreamHeader header{};
+        memcpy(header.magic, VectorStreamHeader::MAGIC, sizeof(header.magic));
+        header.element_size = sizeof(int);
+        header.count = uint64_t{1} << 40;
+        const int data[3] = {1, 2, 3};
+        int fd = open_for_write();
+        WriteAll(fd, &header, sizeof(header));
+        WriteAll(fd, data, sizeof(data));
+        close(fd);
+
+        SimpleVector<int> read{7};
+        fd = open(path.c_str(), O_RDONLY);
+        try {
+            ReadFrom(fd, read);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        close(fd);
+        assert((read == SimpleVector<int>{7}));
+
+        fd = open(path.c_str(), O_RDONLY);
+        VectorStreamReader<int> reader(fd);
+        SimpleVector<int> chunked;
+        try {
+            reader.ReadChunk(chunked, numeric_limits<size_t>::max());
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        close(fd);
+        assert(chunked.IsEmpty() && chunked.GetCapacity() * sizeof(int) <= VECTOR_STREAM_PIECE_BYTES);
+    }
+    remove(path.c_str());
+    cout << "Done!"s << endl << endl;
+}
+
+// Проверяет векторизованные алгоритмы против скалярных на всех наборах инструкций
+template <typename T>
+void CheckSimdAlgorithms() {
+    for (simd::SimdLevel level : {simd::SimdLevel::SCALAR, simd::SimdLevel::SSE2, simd::SimdLevel::AVX2}) {
+        simd::SetSimdLevel(level);
+        for (size_t size : {0, 1, 3, 7, 15, 16, 17, 31, 33, 63, 100, 1001}) {
+            SimpleVector<T> v(size);
+            for (size_t i = 0; i < size; ++i) {
+                v[i] = static_cast<T>((i * 37 + 11) % 101);
+            }
+            assert(simd::Sum(v) == simd::scalar::Sum(v.GetData(), size));
+            assert(simd::Count(v, 11) == simd::scalar::Count(v.GetData(), size, T(11)));
+            assert(simd::Find(v, 48) == simd::scalar::Find(v.GetData(), size, T(48)));
+            assert(simd::Find(v, 200) == size);
+            if (size > 0) {
+                assert(simd::MinMax(v) == simd::scalar::MinMax(v.GetData(), size));
+            } else {
+                try {
+                    simd::MinMax(v);
+                    assert(false);
+                } catch (const invalid_argument&) {
+                }
+            }
+
+            SimpleVector<T> copy(v);
+            assert(copy == v && !(copy < v) && !(v < copy));
+            for (size_t pos = 0; pos < size; pos += 7) {
+                copy[pos] = static_cast<T>(copy[pos] + 1);
+                assert(simd::Mismatch(v.GetData(), copy.GetData(), size) == pos);
+                assert(copy != v && v < copy && !(copy < v));
+                copy[pos] = v[pos];
+            }
+            copy.PushBack(T{});
+            assert(v < copy && !(copy < v));
+
+            simd::Fill(copy, 5);
+            assert(simd::Count(copy, 5) == copy.GetSize());
+        }
+    }
+    simd::SetSimdLevel(simd::SimdLevel::AVX2);
+}
+
+void TestSimdAlgorithms() {
+    cout << "Test SIMD algorithms"s << endl;
+    CheckSimdAlgorithms<int32_t>();
+    CheckSimdAlgorithms<uint8_t>();
+    CheckSimdAlgorithms<float>();
+    CheckSimdAlgorithms<double>();
+    {
+        SimpleVector<int32_t> v{-5, 7, -2147483647 - 1, 2147483647, 0, 3, 3, 3, 3};
+        assert(simd::Sum(v) == int64_t{-5 + 7 - 1 + 3 * 4});
+        assert(simd::MinMax(v) == make_pair(-2147483647 - 1, 2147483647));
+    }
+    {
+        SimpleVector<uint8_t> v(1000, 255);
+        assert(simd::Sum(v) == 255000u);
+    }
+    {
+        // NaN не равен самому себе и несравним: векторы не равны, но и не упорядочены
+        const double nan = numeric_limits<double>::quiet_NaN();
+        SimpleVector<double> a{1, 2, nan, 4, 5};
+        SimpleVector<double> b{1, 2, nan, 4, 6};
+        assert(a != a);
+        assert(a < b && !(b < a));
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestInstrumentation() {
+    cout << "Test instrumentation"s << endl;
+    using Counting = SimpleVector<short, allocator<short>, DoublingGrowth, CountingInstrumentation>;
+    static_assert(sizeof(Counting) == sizeof(SimpleVector<short>));
+
+    static size_t growth_calls = 0;
+    CountingInstrumentation::Reset();
+    CountingInstrumentation::SetGrowthCallback([](const char*, GrowthSource, size_t, size_t) {
+        ++growth_calls;
+    });
+    {
+        Counting v;
+        for (short i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        v.Reserve(20);
+        v.Resize(30);
+        Counting w(Reserve(2));
+        for (short i = 0; i < 3; ++i) {
+            w.Insert(w.begin(), i);
+        }
+        v.ShrinkToFit();
+    }
+    CountingInstrumentation::SetGrowthCallback(nullptr);
+
+    const VectorStats stats = CountingInstrumentation::GetStats<short>();
+    assert(stats.type_name == "short"s && stats.element_size == sizeof(short));
+    assert(stats.GetGrowthEvents(GrowthSource::PUSH_BACK) == 4);
+    assert(stats.GetGrowthEvents(GrowthSource::RESERVE) == 1);
+    assert(stats.GetGrowthEvents(GrowthSource::RESIZE) == 1);
+    assert(stats.GetGrowthEvents(GrowthSource::INSERT) == 1);
+    assert(stats.GetGrowthEvents(GrowthSource::SHRINK) == 1);
+    assert(growth_calls == 8 && stats.in_place_growths == 0);
+    assert(stats.allocations == 9 && stats.releases == 9);
+    assert(stats.bytes_allocated == (1 + 2 + 4 + 8 + 20 + 40 + 2 + 4 + 30) * sizeof(short));
+    // Перенесены элементы при росте 1→2→4→8, Reserve, Resize, вставке и сжатии
+    assert(stats.bytes_relocated == (1 + 2 + 4 + 5 + 5 + 2 + 30) * sizeof(short));
+    assert(stats.max_size == 30 && stats.max_capacity == 40);
+    // Пустые места: 8-5 при Reserve, 20-5 при Resize, 40-30 при сжатии, 4-3 у w
+    assert(stats.unused_bytes_at_release == (3 + 15 + 10 + 1) * sizeof(short));
+
+    {
+        SimpleVector<unsigned, MmapAllocator<unsigned>, DoublingGrowth, CountingInstrumentation> v;
+        for (unsigned i = 0; i < 100000; ++i) {
+            v.PushBack(i);
+        }
+        const VectorStats mmap_stats = CountingInstrumentation::GetStats<unsigned>();
+        assert(mmap_stats.allocations == 1 && mmap_stats.in_place_growths > 0 && mmap_stats.bytes_relocated == 0);
+    }
+
+    ostringstream dump;
+    CountingInstrumentation::Dump(dump);
+    assert(dump.str().find("short: element_size=2"s) != string::npos);
+    assert(dump.str().find("unsigned int: "s) != string::npos);
+    cout << "Done!"s << endl << endl;
+}
+
+// Тип для проверки отката параллельного создания: бросает при копировании значения -1
+struct ParallelThrowing {
+    explicit ParallelThrowing(int v)
+        : value(v) {
+        ++alive;
+    }
+    ParallelThrowing(const ParallelThrowing& other)
+        : value(other.value) {
+        if (value < 0) {
+            throw runtime_error("copy failed"s);
+        }
+        ++alive;
+    }
+    ParallelThrowing(ParallelThrowing&& other) noexcept
+        : value(other.value) {
+        ++alive;
+    }
+    ParallelThrowing& operator=(const ParallelThrowing&) = default;
+    ParallelThrowing& operator=(ParallelThrowing&&) noexcept = default;
+    ~ParallelThrowing() {
+        --alive;
+    }
+
+    int value;
+    inline static atomic<int> alive = 0;
+};
+
+void TestParallelAlgorithms() {
+    cout << "Test parallel algorithms"s << endl;
+    parallel::ThreadPool pool(4);
+    assert(pool.GetThreadCount() == 4);
+    {
+        // Границы кусков внутри массива выровнены по кэш-линии
+        alignas(64) static int data[100000];
+        const parallel::ChunkPlan plan(data + 3, sizeof(int), 99990, 4);
+        assert(plan.GetChunkCount() > 1);
+        size_t expected_begin = 0;
+        for (size_t k = 0; k < plan.GetChunkCount(); ++k) {
+            const auto [begin, end] = plan.GetChunk(k);
+            assert(begin == expected_begin && begin < end);
+            if (k != 0) {
+                assert(reinterpret_cast<uintptr_t>(data + 3 + begin) % parallel::CACHE_LINE_SIZE == 0);
+            }
+            expected_begin = end;
+        }
+        assert(expected_begin == 99990);
+        assert(parallel::ChunkPlan(data, sizeof(int), 0, 4).GetChunkCount() == 0);
+    }
+    {
+        const size_t n = 300000;
+        SimpleVector<int> v(n);
+        parallel::Fill(v, 3, pool);
+        assert(count(v.begin(), v.end(), 3) == static_cast<ptrdiff_t>(n));
+        parallel::ForEach(v, [](int& x) {
+            ++x;
+        }, pool);
+        assert(parallel::Reduce(v, int64_t{0}, plus<>(), pool) == static_cast<int64_t>(4 * n));
+
+        SimpleVector<int64_t> squares;
+        parallel::Transform(v, squares, [](int x) {
+            return int64_t{x} * x;
+        }, pool);
+        assert(squares.GetSize() == n && squares[n - 1] == 16);
+
+        SimpleVector<int> copy = parallel::Copy(v, pool);
+        assert(copy == v);
+        parallel::Resize(copy, n + 1000, 7, pool);
+        assert(copy.GetSize() == n + 1000 && copy[n - 1] == 4 && copy[n] == 7 && copy[n + 999] == 7);
+        parallel::Resize(copy, 10, 0, pool);
+        assert(copy.GetSize() == 10);
+
+        // Значение из самого вектора и преобразование вектора в себя
+        copy.ShrinkToFit();
+        copy[0] = 42;
+        parallel::Resize(copy, 5000, copy[0], pool);
+        assert(copy.GetSize() == 5000 && copy[1] == 4 && copy[10] == 42 && copy[4999] == 42);
+        parallel::Transform(copy, copy, [](int x) {
+            return x + 1;
+        }, pool);
+        assert(copy.GetSize() == 5000 && copy[0] == 43 && copy[1] == 5 && copy[4999] == 43);
+
+        for (size_t i = 0; i < n; ++i) {
+            v[i] = static_cast<int>((i * 2654435761u) % 1000003);
+        }
+        SimpleVector<int> expected = v;
+        sort(expected.begin(), expected.end());
+        parallel::Sort(v, less<>(), pool);
+        assert(v == expected);
+        parallel::Sort(v, greater<>(), pool);
+        assert(is_sorted(v.begin(), v.end(), greater<>()));
+    }
+    {
+        // Строки: пул по умолчанию и диапазоны итераторов
+        SimpleVector<string> words(50000, "ab"s);
+        parallel::ForEach(words.begin(), words.end(), [](string& s) {
+            s += 'c';
+        });
+        vector<size_t> lengths(words.GetSize());
+        parallel::Transform(words.begin(), words.end(), lengths.begin(), [](const string& s) {
+            return s.size();
+        });
+        assert(parallel::Reduce(lengths.begin(), lengths.end(), size_t{0}) == 3 * words.GetSize());
+        SimpleVector<string> copy = parallel::Copy(words);
+        assert(copy == words && copy[0] == "abc"s);
+    }
+    {
+        // Исключение из параллельного создания: созданные элементы разрушаются, вектор не меняется
+        SimpleVector<ParallelThrowing> source(Reserve(200000));
+        for (int i = 0; i < 200000; ++i) {
+            source.EmplaceBack(i == 150000 ? -1 : i);
+        }
+        SimpleVector<ParallelThrowing> target;
+        target.EmplaceBack(1);
+        try {
+            parallel::Transform(source, target, [](const ParallelThrowing& x) {
+                return x;
+            }, pool);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(target.IsEmpty() && ParallelThrowing::alive == 200000);
+
+        // Исключение из ForEach пробрасывается вызывающему
+        try {
+            parallel::ForEach(source, [](ParallelThrowing& x) {
+                if (x.value < 0) {
+                    throw runtime_error("bad value"s);
+                }
+            }, pool);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+    }
+    assert(ParallelThrowing::alive == 0);
+    {
+        // Вложенные вызовы: ожидающий поток выполняет задачи пула сам
+        SimpleVector<SimpleVector<int>> rows(8, SimpleVector<int>(100000, 1));
+        parallel::ForEach(rows, [&pool](SimpleVector<int>& row) {
+            parallel::Fill(row, 2, pool);
+        }, pool);
+        for (const auto& row : rows) {
+            assert(parallel::Reduce(row, 0, plus<>(), pool) == 200000);
+        }
+        // Пул из одного потока выполняет всё в вызывающем
+        parallel::ThreadPool single(1);
+        parallel::Fill(rows[0], 5, single);
+        assert(rows[0][99999] == 5);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+// Сколько выделений FailingAllocator выполнит до отказа. Счётчик общий для всех типов элементов:
+// контейнер выделяет память аллокатором, перепривязанным к своему внутреннему типу
+inline size_t allocations_before_failure = numeric_limits<size_t>::max();
+
+// Аллокатор, который один раз бросает std::bad_alloc, когда счётчик allocations_before_failure
+// обнуляется, и дальше снова выделяет память
+template <typename Type>
+struct FailingAllocator {
+    using value_type = Type;
+
+    FailingAllocator() noexcept = default;
+    template <typename Other>
+    FailingAllocator(const FailingAllocator<Other>&) noexcept {
+    }
+
+    Type* allocate(size_t n) {
+        if (allocations_before_failure-- == 0) {
+            throw bad_alloc();
+        }
+        return std::allocator<Type>{}.allocate(n);
+    }
+    void deallocate(Type* ptr, size_t n) noexcept {
+        std::allocator<Type>{}.deallocate(ptr, n);
+    }
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const FailingAllocator<Lhs>&, const FailingAllocator<Rhs>&) noexcept {
+    return true;
+}
+
+void TestConcurrentSimpleVector() {
+    cout << "Test concurrent simple vector"s << endl;
+    {
+        ConcurrentSimpleVector<string> v;
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        v.PushBack("a"s);
+        const string* first = &v[0];
+        for (int i = 1; i < 1000; ++i) {
+            v.EmplaceBack(to_string(i));
+        }
+        // Корзины не переносятся: адреса элементов не меняются
+        assert(&v[0] == first && *first == "a"s);
+        assert(v.GetSize() == 1000 && v.GetCapacity() >= 1000 && v[999] == "999"s);
+        assert(v.IsReady(999) && !v.IsReady(1000));
+        assert(v.At(7) == "7"s);
+        try {
+            v.At(1000);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+        size_t count = 0;
+        for (const string& s : v) {
+            assert(s == (count == 0 ? "a"s : to_string(count)));
+            ++count;
+        }
+        assert(count == 1000 && v.end() - v.begin() == 1000);
+        ConcurrentSimpleVector<string>::ConstIterator it = v.begin();
+        assert(it[5] == "5"s && *(it + 10) == "10"s);
+
+        v.Clear();
+        assert(v.IsEmpty() && v.GetCapacity() >= 1000);
+        v.Reserve(5000);
+        const size_t capacity = v.GetCapacity();
+        assert(capacity >= 5000);
+        for (int i = 0; i < 5000; ++i) {
+            v.PushBack("x"s);
+        }
+        assert(v.GetCapacity() == capacity);
+    }
+    {
+        // Исключение из конструктора не занимает индекс
+        ConcurrentSimpleVector<ParallelThrowing> v;
+        const ParallelThrowing bad(-1);
+        v.EmplaceBack(1);
+        try {
+            v.PushBack(bad);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(v.GetSize() == 1 && v[0].value == 1);
+    }
+    assert(ParallelThrowing::alive == 0);
+    {
+        // Писатели добавляют одновременно, читатель обходит вектор во время записи
+        const size_t writers = 4;
+        const size_t per_writer = 20000;
+        ConcurrentSimpleVector<size_t> v;
+        atomic<bool> done = false;
+        thread reader([&] {
+            while (!done.load()) {
+                for (size_t value : v) {
+                    assert(value < writers * per_writer);
+                }
+            }
+        });
+        vector<thread> threads;
+        for (size_t t = 0; t < writers; ++t) {
+            threads.emplace_back([&v, t] {
+                for (size_t i = 0; i < per_writer; ++i) {
+                    v.PushBack(i * writers + t);
+                }
+            });
+        }
+        for (thread& writer : threads) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+
+        assert(v.GetSize() == writers * per_writer);
+        vector<bool> seen(writers * per_writer);
+        for (size_t value : v) {
+            assert(!seen[value]);
+            seen[value] = true;
+        }
+        assert(all_of(seen.begin(), seen.end(), [](bool b) {
+            return b;
+        }));
+    }
+    {
+        // Неудачное выделение корзины не занимает индекс и не портит вектор: следующая запись
+        // выделяет корзину заново
+        ConcurrentSimpleVector<int, FailingAllocator<int>> v;
+        for (int i = 0; i < 8; ++i) {
+            v.PushBack(i);
+        }
+        allocations_before_failure = 0;
+        try {
+            v.PushBack(8);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        allocations_before_failure = numeric_limits<size_t>::max();
+        assert(v.GetSize() == 8 && v.GetCapacity() == 8 && !v.IsReady(8));
+        for (int i = 8; i < 30; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.GetSize() == 30);
+        int expected = 0;
+        for (int value : v) {
+            assert(value == expected++);
+        }
+        assert(expected == 30);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSoaVector() {
+    cout << "Test structure of arrays vector"s << endl;
+    {
+        SoaVector<int, double, string> v;
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        v.PushBack({1, 1.5, "one"s});
+        v.EmplaceBack(2, 2.5, "two");
+        v.PushBack(make_tuple(3, 3.5, "three"s));
+        assert(v.GetSize() == 3 && v.GetCapacity() >= 3);
+
+        // Поля строки — по номеру, по типу и структурным связыванием
+        assert(v[0].Get<0>() == 1 && v[1].Get<double>() == 2.5 && v[2].Get<string>() == "three"s);
+        auto [id, weight, name] = v[1];
+        weight = 20.5;
+        name += "!"s;
+        assert(v[1].Get<1>() == 20.5 && v[1].Get<2>() == "two!"s && id == 2);
+        v[2] = make_tuple(30, 30.5, "thirty"s);
+        assert(v[2] == make_tuple(30, 30.5, "thirty"s));
+        const tuple<int, double, string> row = v.At(0);
+        assert(get<2>(row) == "one"s);
+        try {
+            v.At(3);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+
+        // Столбцы непрерывны
+        const ColumnSpan<double> weights = v.Column<double>();
+        assert(weights.GetSize() == 3 && weights.end() - weights.begin() == 3 && weights[1] == 20.5);
+        ColumnSpan<int> ids = v.Column<0>();
+        ids[0] = 10;
+        assert(v[0].Get<int>() == 10 && &v.Column<0>()[2] == &ids[0] + 2);
+
+        auto it = v.Insert(v.begin() + 1, make_tuple(5, 5.5, "five"s));
+        assert(it == v.begin() + 1 && v.GetSize() == 4 && (*it).Get<int>() == 5 && v[2].Get<int>() == 2);
+        it = v.Erase(v.begin());
+        assert(it == v.begin() && v.GetSize() == 3 && v[0].Get<int>() == 5);
+        v.Erase(v.begin() + 1, v.end());
+        assert(v.GetSize() == 1);
+
+        v.Reserve(100);
+        assert(v.GetCapacity() >= 100);
+        v.Resize(4);
+        assert(v.GetSize() == 4 && v[3] == make_tuple(0, 0.0, ""s));
+        v.PopBack();
+        assert(v.GetSize() == 3);
+
+        const SoaVector<int, double, string>& cv = v;
+        int id_sum = 0;
+        for (SoaVector<int, double, string>::ConstReference ref : cv) {
+            id_sum += ref.Get<int>();
+        }
+        assert(id_sum == 5);
+        SoaVector<int, double, string> copy = v;
+        assert(copy == v);
+        copy.Clear();
+        assert(copy.IsEmpty() && copy != v);
+    }
+    {
+        // Сортировка через прокси-ссылки и SIMD по столбцу
+        SoaVector<int, float> v{{3, 0.5f}, {1, 1.5f}, {2, 2.0f}};
+        sort(v.begin(), v.end(), [](const auto& lhs, const auto& rhs) {
+            return get<0>(lhs) < get<0>(rhs);
+        });
+        assert(v[0] == make_tuple(1, 1.5f) && v[2] == make_tuple(3, 0.5f));
+        assert(simd::Sum(v.Column<float>()) == 4.0f);
+        assert(simd::Find(v.Column<int>(), 2) == 1);
+    }
+    {
+        // Исключение из поля откатывает уже изменённые столбцы
+        SoaVector<int, ParallelThrowing> v;
+        v.EmplaceBack(1, 1);
+        const ParallelThrowing bad(-1);
+        try {
+            v.PushBack(make_tuple(2, bad));
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(v.GetSize() == 1 && v.Column<int>().GetSize() == 1);
+        try {
+            v.Insert(v.begin(), make_tuple(0, bad));
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        assert(v.GetSize() == 1 && v[0].Get<int>() == 1 && v[0].Get<1>().value == 1);
+    }
+    assert(ParallelThrowing::alive == 0);
+    cout << "Done!"s << endl << endl;
+}
+
+void TestCowSimpleVector() {
+    cout << "Test copy-on-write vector"s << endl;
+    {
+        CowSimpleVector<string> v{"a"s, "b"s, "c"s};
+        CowSimpleVector<string> snapshot = v;
+        // Копия делит буфер
+        assert(snapshot.GetUseCount() == 2 && v.IsShared());
+        assert(&as_const(snapshot)[0] == &as_const(v)[0]);
+
+        // Первая запись отцепляет буфер, снимок не меняется
+        v[0] = "x"s;
+        assert(!v.IsShared() && !snapshot.IsShared());
+        assert(snapshot[0] == "a"s && v[0] == "x"s);
+
+        CowSimpleVector<string> second = snapshot;
+        second.PushBack("d"s);
+        assert(second.GetSize() == 4 && snapshot.GetSize() == 3 && !snapshot.IsShared());
+
+        CowSimpleVector<string> third = snapshot;
+        third.Insert(third.cbegin() + 1, "y"s);
+        assert((third.Read() == SimpleVector<string>{"a"s, "y"s, "b"s, "c"s}));
+        third = snapshot;
+        third.Erase(third.cbegin(), third.cbegin() + 2);
+        assert(third.GetSize() == 1 && third[0] == "c"s);
+        third = snapshot;
+        third.Resize(5);
+        assert(third.GetSize() == 5 && third[4].empty());
+        third = snapshot;
+        third.PopBack();
+        assert(third.GetSize() == 2 && snapshot.GetSize() == 3);
+        third = snapshot;
+        third.Clear();
+        assert(third.IsEmpty() && third.GetUseCount() == 0 && snapshot.GetUseCount() == 1);
+
+        // Вставка значения из общего буфера в собственную копию
+        CowSimpleVector<string> fourth = snapshot;
+        fourth.Insert(fourth.cbegin(), 2, as_const(snapshot)[2]);
+        assert((fourth.Read() == SimpleVector<string>{"c"s, "c"s, "a"s, "b"s, "c"s}));
+        assert(snapshot == CowSimpleVector<string>({"a"s, "b"s, "c"s}) && fourth != snapshot);
+        assert(snapshot < fourth && snapshot.At(1) == "b"s);
+        try {
+            snapshot.At(3);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+    }
+    {
+        // PopBack у пустого вектора ничего не делает, как у SimpleVector, в том числе у разделённого буфера
+        CowSimpleVector<int> empty;
+        empty.PopBack();
+        assert(empty.IsEmpty());
+        empty.Reserve(8);
+        CowSimpleVector<int> shared = empty;
+        shared.PopBack();
+        assert(shared.IsEmpty() && empty.IsEmpty());
+    }
+    {
+        // Готовый вектор забирается без копирования, пустой вектор не выделяет буфер
+        SimpleVector<int> items(1000, 7);
+        const int* data = &items[0];
+        CowSimpleVector<int> v(std::move(items));
+        assert(&as_const(v)[0] == data && v.GetSize() == 1000);
+        CowSimpleVector<int> empty;
+        CowSimpleVector<int> empty_copy = empty;
+        assert(empty_copy.GetUseCount() == 0 && empty_copy.begin() == empty_copy.end());
+        empty_copy.PushBack(1);
+        assert(empty_copy.GetSize() == 1 && empty.IsEmpty());
+    }
+    {
+        // Снимки читаются и изменяются в разных потоках
+        CowSimpleVector<int> table(10000, 1);
+        vector<thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([snapshot = table, t]() mutable {
+                int64_t sum = 0;
+                for (int value : as_const(snapshot)) {
+                    sum += value;
+                }
+                assert(sum == 10000);
+                snapshot[0] = t;
+                assert(snapshot[0] == t && !snapshot.IsShared());
+            });
+        }
+        table.PushBack(2);
+        for (thread& worker : workers) {
+            worker.join();
+        }
+        assert(table.GetSize() == 10001 && table[0] == 1 && table.GetUseCount() == 1);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestSegmentedVector() {
+    cout << "Test segmented vector"s << endl;
+    {
+        SegmentedVector<int, 4> v;
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        v.PushBack(0);
+        int* first = &v[0];
+        for (int i = 1; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        // Элементы не переносятся: адрес первого не изменился
+        assert(&v[0] == first && v.GetSize() == 100 && v.GetCapacity() == 100);
+        for (int i = 0; i < 100; ++i) {
+            assert(v[i] == i);
+        }
+        assert(v.At(99) == 99);
+        try {
+            v.At(100);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+
+        // Итераторы с произвольным доступом и совместимость с алгоритмами
+        SegmentedVector<int, 4>::Iterator it = v.begin();
+        const auto end = v.end();
+        v.PushBack(100);
+        assert(*(it + 50) == 50 && end - it == 100 && it[99] == 99);
+        assert(lower_bound(v.begin(), v.end(), 42) - v.begin() == 42);
+        SegmentedVector<int, 4>::ConstIterator cit = it;
+        assert(cit == v.cbegin() && *(v.cend() - 1) == 100);
+        reverse(v.begin(), v.end());
+        assert(v[0] == 100 && v[100] == 0);
+        sort(v.begin(), v.end());
+        assert(is_sorted(v.begin(), v.end()));
+
+        auto inserted = v.Insert(v.begin() + 5, v[0]);
+        assert(*inserted == 0 && v[5] == 0 && v[6] == 5 && v.GetSize() == 102);
+        auto after = v.Erase(v.begin() + 5);
+        assert(*after == 5 && v.GetSize() == 101);
+        v.Erase(v.begin() + 10, v.begin() + 20);
+        assert(v.GetSize() == 91 && v[10] == 20);
+
+        v.Resize(3);
+        assert(v.GetSize() == 3 && v.GetCapacity() == 104);
+        v.Resize(6);
+        assert(v[5] == 0);
+        v.Clear();
+        assert(v.IsEmpty() && v.GetCapacity() == 104);
+    }
+    {
+        SegmentedVector<string> v{"a"s, "b"s};
+        SegmentedVector<string> copy = v;
+        copy.PushBack("c"s);
+        assert(v.GetSize() == 2 && copy.GetSize() == 3 && v < copy && v != copy);
+        SegmentedVector<string> moved = std::move(copy);
+        assert(copy.IsEmpty() && moved[2] == "c"s);
+        v = moved;
+        assert(v == moved);
+        SegmentedVector<string> filled(5, "z"s);
+        assert(filled.GetSize() == 5 && filled[4] == "z"s);
+        filled.Reserve(10000);
+        assert(filled.GetCapacity() >= 10000);
+    }
+    {
+        SegmentedVector<Counted, 8> v;
+        for (int i = 0; i < 50; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Erase(v.begin(), v.begin() + 10);
+        assert(Counted::alive == 40 && v[0].GetValue() == 10);
+    }
+    assert(Counted::alive == 0);
+    {
+        // PopBack у пустого вектора ничего не делает, как у SimpleVector
+        SegmentedVector<int, 4> v;
+        v.PopBack();
+        assert(v.IsEmpty() && v.GetSize() == 0);
+        v.PushBack(1);
+        v.PopBack();
+        v.PopBack();
+        assert(v.IsEmpty());
+        v.PushBack(2);
+        assert(v.GetSize() == 1 && v[0] == 2);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestGapBuffer() {
+    cout << "Test gap buffer"s << endl;
+    {
+        GapBuffer<int> v;
+        assert(v.IsEmpty() && v.GetCapacity() == 0);
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        for (int i = 1; i <= 5; ++i) {
+            v.PushFront(-i);
+        }
+        // PushFront и PushBack чередуются через шов кольца без переноса элементов
+        v.PushBack(10);
+        assert(v.GetSize() == 16 && v[0] == -5 && v[5] == 0 && v[15] == 10);
+        assert(v.At(15) == 10);
+        try {
+            v.At(16);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+
+        // Вставки у курсора: разрыв остаётся за вставленным элементом
+        auto cursor = v.Insert(v.begin() + 8, 100);
+        assert(*cursor == 100 && v.GetGapPosition() == 9);
+        for (int i = 101; i < 110; ++i) {
+            cursor = v.Insert(cursor + 1, i);
+        }
+        assert(v.GetGapPosition() == 18 && v[8] == 100 && v[17] == 109 && v[18] == 3);
+        // Удаление перед разрывом присоединяет элемент к разрыву
+        auto after = v.Erase(v.begin() + 17);
+        assert(*after == 3 && v.GetGapPosition() == 17 && v.GetSize() == 25);
+        v.Erase(v.begin() + 8, v.begin() + 17);
+        assert(v.GetSize() == 16 && v[7] == 2 && v[8] == 3);
+
+        vector<int> expected{-5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+        assert(equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        v.PopFront();
+        v.PopBack();
+        assert(v.GetSize() == 14 && v[0] == -4 && v[13] == 9);
+
+        // Итераторы с произвольным доступом и совместимость с алгоритмами
+        reverse(v.begin(), v.end());
+        assert(v[0] == 9 && v[13] == -4);
+        sort(v.begin(), v.end());
+        assert(is_sorted(v.begin(), v.end()));
+        GapBuffer<int>::ConstIterator cit = v.begin();
+        assert(cit == v.cbegin() && v.cend() - cit == 14);
+
+        v.Resize(3);
+        assert(v.GetSize() == 3 && v[2] == -2);
+        v.Resize(5);
+        assert(v[4] == 0);
+        v.Clear();
+        assert(v.IsEmpty() && v.GetCapacity() >= 16);
+    }
+    {
+        // Сверка со std::vector на случайных правках
+        GapBuffer<int> v;
+        vector<int> reference;
+        uint32_t state = 12345;
+        for (int step = 0; step < 5000; ++step) {
+            state = state * 1664525u + 1013904223u;
+            const size_t pos = reference.empty() ? 0 : (state >> 8) % (reference.size() + 1);
+            switch ((state >> 28) % 6) {
+                case 0:
+                case 1:
+                    v.Insert(v.begin() + pos, step);
+                    reference.insert(reference.begin() + pos, step);
+                    break;
+                case 2:
+                    v.PushFront(step);
+                    reference.insert(reference.begin(), step);
+                    break;
+                case 3:
+                    v.PushBack(step);
+                    reference.push_back(step);
+                    break;
+                default:
+                    if (pos < reference.size()) {
+                        v.Erase(v.begin() + pos);
+                        reference.erase(reference.begin() + pos);
+                    }
+            }
+        }
+        assert(v.GetSize() == reference.size() && equal(v.begin(), v.end(), reference.begin()));
+    }
+    {
+        GapBuffer<string> v{"b"s, "c"s};
+        v.PushFront("a"s);
+        // Аргумент ссылается на элемент, который перенос разрыва перемещает
+        v.Insert(v.begin() + 1, v[2]);
+        v.PushFront(v[3]);
+        assert((v == GapBuffer<string>{"c"s, "a"s, "c"s, "b"s, "c"s}));
+        GapBuffer<string> copy = v;
+        copy.PushBack("d"s);
+        assert(v.GetSize() == 5 && v < copy && v != copy);
+        GapBuffer<string> moved = std::move(copy);
+        assert(copy.IsEmpty() && moved[5] == "d"s);
+        v = moved;
+        assert(v == moved);
+        v.Reserve(100);
+        assert(v.GetCapacity() == 100 && v == moved);
+    }
+    {
+        GapBuffer<Counted> v;
+        for (int i = 0; i < 50; ++i) {
+            v.EmplaceFront(i);
+        }
+        v.Erase(v.begin() + 10, v.begin() + 20);
+        v.Emplace(v.begin() + 30, 100);
+        assert(Counted::alive == 41 && v[0].GetValue() == 49 && v[10].GetValue() == 29 && v[30].GetValue() == 100);
+    }
+    assert(Counted::alive == 0);
+    {
+        // PopBack и PopFront у пустого буфера ничего не делают, как SimpleVector::PopBack
+        GapBuffer<string> v;
+        static_assert(noexcept(v.PopBack()) && noexcept(v.PopFront()));
+        v.PopBack();
+        v.PopFront();
+        assert(v.IsEmpty());
+        v.PushBack("a"s);
+        v.PopFront();
+        v.PopBack();
+        v.PopFront();
+        assert(v.IsEmpty());
+        v.PushFront("b"s);
+        assert(v.GetSize() == 1 && v[0] == "b"s);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+#ifdef SIMPLE_VECTOR_HAS_CONSTEXPR
+// Таблица, собранная на этапе компиляции: SimpleVector внутри constexpr-функции,
+// результат копируется в StaticVector, который хранится в .rodata
+constexpr StaticVector<int, 16> MakePrimes() {
+    SimpleVector<int> primes;
+    for (int n = 2; primes.GetSize() < 10; ++n) {
+        bool prime = true;
+        for (int p : primes) {
+            prime = prime && n % p != 0;
+        }
+        if (prime) {
+            primes.PushBack(n);
+        }
+    }
+    return StaticVector<int, 16>(primes);
+}
+
+constexpr auto PRIMES = MakePrimes();
+static_assert(PRIMES.GetSize() == 10 && PRIMES[0] == 2 && PRIMES[9] == 29);
+
+constexpr bool CheckConstexprSimpleVector() {
+    SimpleVector<int> v{3, 1, 2};
+    v.PushBack(5);
+    v.Insert(v.begin() + 1, 7);
+    // Значение из самого вектора: проверка наложения работает и на этапе компиляции
+    v.Insert(v.begin(), v[2]);
+    v.Erase(v.begin() + 2);
+    v.Insert(v.end(), {8, 9});
+    v.Resize(9);
+    SimpleVector<int> copy = v;
+    copy.PopBack();
+    const SimpleVector<int> expected{1, 3, 1, 2, 5, 8, 9, 0, 0};
+    SimpleVector<std::string> words(Reserve(1));
+    words.PushBack("b");
+    words.Insert(words.begin(), "a");
+    return v == expected && copy < v && v.GetCapacity() >= 9 && words[0] == "a" && words.GetSize() == 2;
+}
+static_assert(CheckConstexprSimpleVector());
+
+constexpr StaticVector<int, 4> SMALL_TABLE{1, 2, 3};
+static_assert(SMALL_TABLE.GetSize() == 3 && SMALL_TABLE < StaticVector<int, 4>{1, 2, 4});
+#endif
+
+void TestStaticVector() {
+    cout << "Test static vector"s << endl;
+    static_assert(is_trivially_copyable_v<StaticVector<int, 8>>);
+    {
+        StaticVector<int, 8> v{1, 2, 3};
+        assert(v.GetSize() == 3 && v.GetCapacity() == 8);
+        v.Insert(v.begin() + 1, v[2]);
+        assert((v == StaticVector<int, 8>{1, 3, 2, 3}));
+        v.Erase(v.begin(), v.begin() + 2);
+        assert((v == StaticVector<int, 8>{2, 3}));
+        v.Resize(8);
+        assert(v[7] == 0);
+        // Переполнение бросает std::bad_alloc и не меняет вектор
+        try {
+            v.PushBack(9);
+            assert(false);
+        } catch (const bad_alloc&) {
+        }
+        assert(v.GetSize() == 8);
+        try {
+            v.At(8);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+        v.Clear();
+        assert(v.IsEmpty());
+    }
+    {
+        StaticVector<string, 4> v{"a"s, "b"s};
+        v.Insert(v.begin(), v[1]);
+        StaticVector<string, 4> copy = v;
+        copy.PushBack("c"s);
+        assert(v.GetSize() == 3 && v < copy);
+        v.swap(copy);
+        assert(v.GetSize() == 4 && copy.GetSize() == 3 && v[3] == "c"s && copy[0] == "b"s);
+        copy = v;
+        assert(copy == v);
+        StaticVector<string, 4> moved = std::move(copy);
+        assert(moved == v);
+        const StaticVector<string, 4> from_simple(SimpleVector<string>{"x"s, "y"s});
+        assert(from_simple.GetSize() == 2 && from_simple[1] == "y"s);
+    }
+    {
+        StaticVector<Counted, 4> v;
+        v.EmplaceBack(1);
+        v.EmplaceBack(2);
+        v.Erase(v.begin());
+        assert(Counted::alive == 1 && v[0].GetValue() == 2);
+    }
+    assert(Counted::alive == 0);
+    {
+        // Исключение при копировании разрушает уже созданные копии
+        StaticVector<ThrowingCopy<false>, 4> v;
+        for (int i = 0; i < 3; ++i) {
+            v.EmplaceBack(i);
+        }
+        ThrowingCopy<false>::copies_before_throw = 2;
+        try {
+            StaticVector<ThrowingCopy<false>, 4> copy = v;
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingCopy<false>::copies_before_throw = numeric_limits<size_t>::max();
+        assert(ThrowingCopy<false>::alive == 3);
+    }
+    assert(ThrowingCopy<false>::alive == 0);
+    {
+        // PopBack у пустого вектора ничего не делает, как у SimpleVector
+        StaticVector<int, 4> numbers;
+        numbers.PopBack();
+        assert(numbers.IsEmpty() && numbers.GetSize() == 0);
+        StaticVector<string, 4> words{"a"s};
+        words.PopBack();
+        words.PopBack();
+        assert(words.IsEmpty());
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+// Значение, копирование и перемещение которого бросают исключение после заданного числа удачных
+struct FragileValue {
+    explicit FragileValue(int v)
+        : value(v) {
+    }
+    FragileValue(const FragileValue& other)
+        : value(other.value) {
+        Spend();
+    }
+    FragileValue(FragileValue&& other)
+        : value(other.value) {
+        Spend();
+    }
+    FragileValue& operator=(const FragileValue&) = default;
+    FragileValue& operator=(FragileValue&&) = default;
+
+    static void Spend() {
+        if (constructions_before_throw == 0) {
+            throw runtime_error("construction failed"s);
+        }
+        --constructions_before_throw;
+    }
+
+    int value;
+    inline static size_t constructions_before_throw = numeric_limits<size_t>::max();
+};
+
+// Сравнение строк, которое бросает исключение после заданного числа вызовов
+struct ThrowingLess {
+    bool operator()(const string& lhs, const string& rhs) const {
+        if (calls_before_throw == 0) {
+            throw runtime_error("compare failed"s);
+        }
+        --calls_before_throw;
+        return lhs < rhs;
+    }
+
+    inline static size_t calls_before_throw = numeric_limits<size_t>::max();
+};
+
+void TestFlatContainers() {
+    cout << "Test flat set and flat map"s << endl;
+    {
+        for (size_t n = 0; n < 40; ++n) {
+            SimpleVector<int> sorted;
+            for (size_t i = 0; i < n; ++i) {
+                sorted.PushBack(static_cast<int>(i * 2));
+            }
+            for (int key = -1; key <= static_cast<int>(n * 2); ++key) {
+                const int* found = BranchlessLowerBound(sorted.GetData(), n, key, less<int>());
+                assert(found == lower_bound(sorted.GetData(), sorted.GetData() + n, key));
+            }
+        }
+    }
+    {
+        // Неупорядоченный диапазон сортируется, повторы убираются
+        FlatSet<int> set{5, 1, 4, 1, 5, 9, 2, 6};
+        assert(set.GetSize() == 6 && is_sorted(set.begin(), set.end()));
+        assert(set.Contains(9) && !set.Contains(3) && set.Count(4) == 1);
+        assert(*set.LowerBound(3) == 4 && *set.UpperBound(4) == 5 && set.Find(7) == set.end());
+
+        auto [it, inserted] = set.Insert(3);
+        assert(inserted && *it == 3 && set.GetSize() == 7);
+        assert(!set.Insert(3).second && set.GetSize() == 7);
+        assert(set.Erase(1) == 1 && set.Erase(1) == 0);
+
+        // Пакетная вставка сливает новые ключи с имеющимися
+        set.Insert({10, 0, 4, 10, 7});
+        const FlatSet<int> expected{0, 2, 3, 4, 5, 6, 7, 9, 10};
+        assert(set == expected);
+        set.Erase(set.begin(), set.begin() + 3);
+        assert(*set.begin() == 4 && set.GetSize() == 6);
+
+        FlatSet<int, greater<int>> descending{1, 3, 2};
+        assert(*descending.begin() == 3 && descending.Contains(2));
+        // Множества сравниваются в своём порядке: {3, 2} < {3, 1} по убыванию
+        const FlatSet<int, greater<int>> high{3, 2};
+        const FlatSet<int, greater<int>> low{3, 1};
+        assert(high < low && low > high && high <= low && low >= high && !(low < high));
+        assert(high < descending && descending < low && high <= high && high >= high);
+        FlatSet<string> words(SimpleVector<string>{"b"s, "a"s, "b"s});
+        assert(words.GetSize() == 2 && words.GetStorage()[0] == "a"s);
+    }
+    {
+        FlatMap<string, int> map{{"b"s, 2}, {"a"s, 1}, {"c"s, 3}, {"a"s, 10}};
+        // Из пар с равными ключами остаётся первая
+        assert(map.GetSize() == 3 && map.At("a"s) == 1);
+        assert(map.GetKeys()[0] == "a"s && map.GetValues()[2] == 3);
+        try {
+            map.At("z"s);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+
+        map["d"s] = 4;
+        ++map["a"s];
+        assert(map.GetSize() == 4 && map.At("a"s) == 2 && map.At("d"s) == 4);
+        assert(!map.Insert({"b"s, 20}).second && map.At("b"s) == 2);
+        assert(!map.InsertOrAssign("b"s, 20).second && map.At("b"s) == 20);
+        auto [it, inserted] = map.TryEmplace("bb"s, 7);
+        assert(inserted && it->first == "bb"s && it->second == 7 && (it + 1)->first == "c"s);
+
+        map.Insert({{"e"s, 5}, {"a"s, 100}, {"0"s, 0}});
+        SimpleVector<string> keys;
+        int sum = 0;
+        for (const auto& [key, value] : map) {
+            keys.PushBack(key);
+            sum += value;
+        }
+        assert((keys == SimpleVector<string>{"0"s, "a"s, "b"s, "bb"s, "c"s, "d"s, "e"s}));
+        assert(sum == 0 + 2 + 20 + 7 + 3 + 4 + 5);
+
+        for (auto [key, value] : map) {
+            value *= 2;
+        }
+        assert(map.At("e"s) == 10 && map.Find("bb"s)->second == 14);
+        assert(map.Erase("bb"s) == 1 && map.Erase("bb"s) == 0 && map.GetSize() == 6);
+        map.Erase(map.begin(), map.LowerBound("c"s));
+        assert(map.begin()->first == "c"s && map.GetSize() == 3);
+        assert(map.Find("zz"s) == map.end() && map.UpperBound("c"s)->first == "d"s);
+
+        FlatMap<string, int> copy = map;
+        assert(copy == map);
+        copy["f"s];
+        assert(copy != map && copy.At("f"s) == 0);
+    }
+    {
+        // Исключение при вставке значения не оставляет ключ без значения
+        FlatMap<int, ThrowingCopy<false>> map;
+        const ThrowingCopy<false> value(1);
+        ThrowingCopy<false>::copies_before_throw = 0;
+        try {
+            map.TryEmplace(1, value);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingCopy<false>::copies_before_throw = numeric_limits<size_t>::max();
+        assert(map.IsEmpty() && map.GetKeys().IsEmpty());
+    }
+    {
+        // Пакетная вставка не меняет словарь, если значение бросает при копировании,
+        // даже когда ключи перемещаются без исключений
+        FlatMap<string, FragileValue> map;
+        for (int i = 0; i < 6; ++i) {
+            map.TryEmplace(string(20, static_cast<char>('a' + 2 * i)), i);
+        }
+        const vector<pair<string, FragileValue>> batch{{string(20, 'b'), FragileValue(10)},
+                                                       {string(20, 'z'), FragileValue(11)}};
+        bool inserted = false;
+        for (size_t budget = 0; !inserted; ++budget) {
+            FragileValue::constructions_before_throw = budget;
+            try {
+                map.Insert(batch.begin(), batch.end());
+                inserted = true;
+            } catch (const runtime_error&) {
+                assert(map.GetSize() == 6);
+                for (int i = 0; i < 6; ++i) {
+                    const auto it = map.begin() + i;
+                    assert(it->first == string(20, static_cast<char>('a' + 2 * i)) && it->second.value == i);
+                }
+            }
+        }
+        FragileValue::constructions_before_throw = numeric_limits<size_t>::max();
+        assert(map.GetSize() == 8 && map.At(string(20, 'b')).value == 10 && map.At(string(20, 'z')).value == 11);
+    }
+    {
+        // Пакетная вставка не меняет словарь и тогда, когда бросает сравнение ключей
+        FlatMap<string, int, ThrowingLess> map;
+        for (int i = 0; i < 6; ++i) {
+            map.TryEmplace(string(20, static_cast<char>('a' + 2 * i)), i);
+        }
+        const vector<pair<string, int>> batch{{string(20, 'b'), 10}, {string(20, 'e'), 11}, {string(20, 'z'), 12}};
+        bool inserted = false;
+        for (size_t budget = 0; !inserted; ++budget) {
+            ThrowingLess::calls_before_throw = budget;
+            try {
+                map.Insert(batch.begin(), batch.end());
+                inserted = true;
+            } catch (const runtime_error&) {
+                ThrowingLess::calls_before_throw = numeric_limits<size_t>::max();
+                assert(map.GetSize() == 6);
+                for (int i = 0; i < 6; ++i) {
+                    const auto it = map.begin() + i;
+                    assert(it->first == string(20, static_cast<char>('a' + 2 * i)) && it->second == i);
+                }
+            }
+        }
+        ThrowingLess::calls_before_throw = numeric_limits<size_t>::max();
+        assert(map.GetSize() == 8 && map.At(string(20, 'b')) == 10 && map.At(string(20, 'z')) == 12);
+        assert(map.At(string(20, 'e')) == 2);
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+#ifdef SIMPLE_VECTOR_DEBUG
+// Выполняет action в дочернем процессе и проверяет, что проверка отладочного режима его прервала
+template <typename Action>
+void ExpectCheckFailure(Action action) {
+    const pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        const int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDERR_FILENO);
+        action();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    assert(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+}
+#endif
+
+void TestCheckedIterators() {
+    cout << "Test checked iterators"s << endl;
+#ifdef SIMPLE_VECTOR_DEBUG
+    static_assert(!is_same_v<SimpleVector<int>::Iterator, int*>);
+    {
+        // Действительные итераторы работают как указатели
+        SimpleVector<int> v{1, 2, 3};
+        v.Reserve(8);
+        auto it = v.begin();
+        v.PushBack(4);
+        assert(*it == 1 && it[3] == 4 && v.end() - it == 4);
+        SimpleVector<int>::ConstIterator const_it = it + 1;
+        assert(*const_it == 2);
+        const auto next = v.Erase(const_it);
+        assert(next == v.begin() + 1 && *next == 3);
+        assert(UnwrapIterator(v.begin()) == v.GetData() && UnwrapIterator(v.end()) == v.GetData() + 3);
+
+        // Итераторы, созданные по умолчанию, равны друг другу
+        SimpleVector<int>::Iterator first{};
+        SimpleVector<int>::ConstIterator second{};
+        assert(first == SimpleVector<int>::Iterator{} && !(second != SimpleVector<int>::ConstIterator{}));
+        assert(first - SimpleVector<int>::Iterator{} == 0 && !(second < SimpleVector<int>::ConstIterator{}));
+    }
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        static_cast<void>(v.begin() == SimpleVector<int>::Iterator{});
+    });
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        auto it = v.begin();
+        v.Reserve(100);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        v.Reserve(100);
+        auto it = v.begin() + 2;
+        v.Insert(v.begin(), 0);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        auto it = v.begin();
+        v.Erase(v.begin() + 2);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        auto it = v.begin();
+        v.Resize(2);
+        static_cast<void>(*it);
+    });
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        static_cast<void>(v[3]);
+    });
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        static_cast<void>(*v.end());
+    });
+    ExpectCheckFailure([] {
+        SimpleVector<int> v{1, 2, 3};
+        SimpleVector<int> other{4, 5};
+        v.Erase(other.begin());
+    });
+#else
+    // Без отладочного режима итераторы — указатели и проверок нет
+    static_assert(is_same_v<SimpleVector<int>::Iterator, int*>);
+    static_assert(is_same_v<SimpleVector<string>::ConstIterator, const string*>);
+    SimpleVector<int> v{1, 2, 3};
+    assert(v.begin() == v.GetData() && v.end() == v.GetData() + 3);
+#endif
+    cout << "Done!"s << endl << endl;
+}
+
+// Сверяет PackedVector<T> со std::vector<T> на случайных правках: значения из узкого окна
+// и редкие выбросы до границ типа, которые перепаковывают блоки
+template <typename T>
+void CheckPackedVectorAgainstVector() {
+    PackedVector<T> v;
+    vector<T> reference;
+    uint64_t state = 2024;
+    auto next = [&state] {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        return state >> 16;
+    };
+    auto make_value = [&](size_t i) {
+        const uint64_t r = next();
+        if (r % 50 == 0) {
+            return r % 2 == 0 ? numeric_limits<T>::max() : numeric_limits<T>::min();
+        }
+        return static_cast<T>(static_cast<T>(i) + static_cast<T>(r % 16));
+    };
+    for (int step = 0; step < 20000; ++step) {
+        const uint64_t op = next() % 10;
+        if (op < 5 || reference.empty()) {
+            const T value = make_value(reference.size());
+            v.PushBack(value);
+            reference.push_back(value);
+        } else if (op < 8) {
+            const size_t index = next() % reference.size();
+            const T value = make_value(index);
+            v.Set(index, value);
+            reference[index] = value;
+        } else if (op == 8) {
+            v.PopBack();
+            reference.pop_back();
+        } else if (next() % 20 == 0) {
+            const size_t new_size = next() % (reference.size() + 300);
+            v.Resize(new_size, T{7});
+            reference.resize(new_size, T{7});
+        }
+    }
+    assert(v.GetSize() == reference.size());
+    assert(equal(v.begin(), v.end(), reference.begin(), reference.end()));
+    for (simd::SimdLevel level : {simd::SimdLevel::SCALAR, simd::SimdLevel::AVX2}) {
+        simd::SetSimdLevel(level);
+        vector<T> unpacked(reference.size());
+        v.Unpack(0, unpacked.size(), unpacked.data());
+        assert(unpacked == reference);
+        const size_t middle = reference.size() / 3;
+        v.Unpack(middle, 200, unpacked.data());
+        assert(equal(unpacked.begin(), unpacked.begin() + 200, reference.begin() + middle));
+        size_t index = 0;
+        v.ForEach([&](T value) {
+            assert(value == reference[index++]);
+        });
+        assert(index == reference.size());
+    }
+    simd::SetSimdLevel(simd::DetectSimdLevel());
+}
+
+void TestPackedVector() {
+    cout << "Test packed vector"s << endl;
+    {
+        // Последовательные идентификаторы: 7 бит вместо 32
+        const SimpleVector<int> ids = GenerateVector(100000);
+        PackedVector<int> v(ids.begin(), ids.end());
+        assert(v.GetSize() == ids.GetSize() && v[0] == 1 && v[99999] == 100000);
+        assert(v.GetBitsPerValue() == 7);
+        v.ShrinkToFit();
+        assert(v.GetAllocatedBytes() * 3 < ids.GetCapacity() * sizeof(int));
+        assert(equal(v.begin(), v.end(), ids.begin(), ids.end()));
+        assert(v.At(5) == 6);
+        try {
+            v.At(100000);
+            assert(false);
+        } catch (const out_of_range&) {
+        }
+
+        // Запись в диапазон блока не перепаковывает его, выброс перепаковывает
+        v.Set(10, 20);
+        assert(v[10] == 20 && v.GetBitsPerValue() == 7);
+        v.Set(11, -1000000);
+        assert(v[11] == -1000000 && v[10] == 20 && v[12] == 13 && v.GetBitsPerValue() > 7);
+        // Значение в диапазоне расширенного блока тоже пишется на место: блок не сужается
+        const double wide = v.GetBitsPerValue();
+        v.Set(11, 12);
+        assert(v[11] == 12 && v.GetBitsPerValue() == wide);
+    }
+    {
+        PackedVector<uint64_t> v(300, 5);
+        assert(v.GetSize() == 300 && v[299] == 5 && v.GetBitsPerValue() == 0);
+        v.PushBack(numeric_limits<uint64_t>::max());
+        v.Resize(1000, 0);
+        assert(v[300] == numeric_limits<uint64_t>::max() && v.GetBitsPerValue() == 64 / 7.0);
+        PackedVector<uint64_t> copy = v;
+        assert(copy == v);
+        PackedVector<uint64_t> moved = std::move(copy);
+        assert(moved == v && copy.IsEmpty());
+        copy.PushBack(1);
+        assert(copy.GetSize() == 1 && copy[0] == 1);
+        v.Resize(130);
+        assert(v.GetSize() == 130 && v[129] == 5 && moved != v);
+        v.Clear();
+        assert(v.IsEmpty());
+    }
+    CheckPackedVectorAgainstVector<int32_t>();
+    CheckPackedVectorAgainstVector<int64_t>();
+    CheckPackedVectorAgainstVector<uint32_t>();
+    CheckPackedVectorAgainstVector<uint64_t>();
+    CheckPackedVectorAgainstVector<int16_t>();
+    {
+        // Запись в диапазон блока с отрицательным минимумом идёт на место, без перепаковки
+        SimpleVector<int> values(1024);
+        for (size_t i = 0; i < values.GetSize(); ++i) {
+            values[i] = static_cast<int>(i % 128) - 64;
+        }
+        PackedVector<int> v(values.begin(), values.end());
+        v.ShrinkToFit();
+        const size_t bytes = v.GetAllocatedBytes();
+        assert(v.GetBitsPerValue() == 7);
+        for (size_t i = 0; i < v.GetSize(); ++i) {
+            v.Set(i, static_cast<int>((i * 37) % 128) - 64);
+        }
+        assert(v.GetAllocatedBytes() == bytes && v.GetBitsPerValue() == 7);
+        for (size_t i = 0; i < v.GetSize(); ++i) {
+            assert(v[i] == static_cast<int>((i * 37) % 128) - 64);
+        }
+    }
+    cout << "Done!"s << endl << endl;
+}
+
+void TestPipeline() {
+    cout << "Test pipeline"s << endl;
+    const SimpleVector<int> v = GenerateVector(1000);
+    {
+        // Без Filter число элементов известно: одно выделение ровно под них
+        SimpleVector<long long> squares;
+        auto pipeline = MakePipeline(v).Map([](int x) {
+            return static_cast<long long>(x) * x;
+        });
+        static_assert(decltype(pipeline)::GetSizeKind() == pipeline::SizeKind::EXACT);
+        pipeline.CollectInto(squares);
+        assert(squares.GetSize() == 1000 && squares.GetCapacity() == 1000);
+        assert(squares[0] == 1 && squares[999] == 1000000);
+
+        // После Filter известна только верхняя граница; малая доля отобранных — память отдаётся
+        SimpleVector<int> rare{-1, -2};
+        MakePipeline(v)
+            .Filter([](int x) {
+                return x % 100 == 0;
+            })
+            .CollectInto(rare);
+        assert(rare.GetSize() == 12 && rare[0] == -1 && rare[2] == 100 && rare[11] == 1000);
+        assert(rare.GetCapacity() == 12);
+
+        SimpleVector<int> many;
+        MakePipeline(v)
+            .Filter([](int x) {
+                return x % 4 != 0;
+            })
+            .CollectInto(many);
+        assert(many.GetSize() == 750 && many.GetCapacity() == 1000);
+    }
+    {
+        // Take останавливает обход источника
+        size_t visited = 0;
+        SimpleVector<string> out;
+        auto pipeline = MakePipeline(v)
+                            .Filter([&visited](int x) {
+                                ++visited;
+                                return x % 2 == 0;
+                            })
+                            .Map([](int x) {
+                                return to_string(x);
+                            })
+                            .Take(3);
+        assert(pipeline.SizeHint() == 3 && visited == 0);
+        pipeline.CollectInto(out);
+        assert((out == SimpleVector<string>{"2"s, "4"s, "6"s}) && visited == 6);
+        out.Clear();
+        MakePipeline(v).Take(0).Map([](int x) {
+            return to_string(x);
+        }).CollectInto(out);
+        assert(out.IsEmpty());
+    }
+    {
+        // Пачки: последняя короче, Take после Batch считает пачки
+        SimpleVector<size_t> sizes;
+        SimpleVector<int> sums;
+        auto batches = MakePipeline(v).Take(10).Batch(4);
+        assert(batches.SizeHint() == 3);
+        batches.ForEach([&](const SimpleVector<int>& batch) {
+            sizes.PushBack(batch.GetSize());
+            sums.PushBack(accumulate(batch.begin(), batch.end(), 0));
+        });
+        assert((sizes == SimpleVector<size_t>{4, 4, 2}) && (sums == SimpleVector<int>{10, 26, 19}));
+        sizes.Clear();
+        MakePipeline(v).Batch(300).Take(2).ForEach([&](const SimpleVector<int>& batch) {
+            sizes.PushBack(batch.GetSize());
+        });
+        assert((sizes == SimpleVector<size_t>{300, 300}));
+        try {
+            MakePipeline(v).Batch(0);
+            assert(false);
+        } catch (const invalid_argument&) {
+        }
+    }
+    {
+        // Элементы без копирования передаются по ссылке
+        SimpleVector<unique_ptr<int>> owners;
+        for (int i = 0; i < 5; ++i) {
+            owners.PushBack(make_unique<int>(i));
+        }
+        SimpleVector<unique_ptr<int>> taken;
+        MakePipeline(owners)
+            .Filter([](const unique_ptr<int>& p) {
+                return *p % 2 == 1;
+            })
+            .Map([](unique_ptr<int>& p) {
+                return std::move(p);
+            })
+            .CollectInto(taken);
+        assert(taken.GetSize() == 2 && *taken[0] == 1 && *taken[1] == 3 && !owners[1] && owners[2]);
+
+        // Источник без operator-: размер неизвестен, вектор растёт сам
+        const list<int> values{3, 1, 4, 1, 5};
+        SimpleVector<int> out;
+        auto pipeline = MakePipeline(values);
+        static_assert(decltype(pipeline)::GetSizeKind() == pipeline::SizeKind::UNKNOWN);
+        pipeline.CollectInto(out);
+        assert((out == SimpleVector<int>{3, 1, 4, 1, 5}));
+    }
+    {
+        // Предвыборка не меняет обход: вектор указателей в перемешанную таблицу
+        SimpleVector<int> table = GenerateVector(5000);
+        SimpleVector<const int*> pointers;
+        for (size_t i = 0; i < table.GetSize(); ++i) {
+            pointers.PushBack(&table[(i * 7919) % table.GetSize()]);
+        }
+        long long expected = accumulate(table.begin(), table.end(), 0ll);
+        for (size_t distance : {0, 1, 8, 64, 10000}) {
+            long long sum = 0;
+            for (const int* p : Prefetched(pointers, distance)) {
+                sum += *p;
+            }
+            assert(sum == expected);
+        }
+
+        SimpleVector<size_t> ids;
+        for (size_t i = 0; i < 100; ++i) {
+            ids.PushBack((i * 37) % table.GetSize());
+        }
+        SimpleVector<int> rows;
+        auto pipeline = MakePipeline(Prefetched(ids, 4, [&table](size_t id) {
+                            return &table[id];
+                        }))
+                            .Map([&table](size_t id) {
+                                return table[id];
+                            });
+        static_assert(decltype(pipeline)::GetSizeKind() == pipeline::SizeKind::EXACT);
+        pipeline.CollectInto(rows);
+        assert(rows.GetSize() == 100 && rows.GetCapacity() == 100 && rows[1] == 38);
+
+        SimpleVector<int> empty;
+        assert(Prefetched(empty).begin() == Prefetched(empty).end());
+    }
+    cout << "Done!"s << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -159,5 +2290,28 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestUninitializedStorage();
+    TestEmplace();
+    TestAllocators();
+    TestTriviallyRelocatable();
+    TestSmallSimpleVector();
+    TestGrowthPolicies();
+    TestMmapAllocator();
+    TestFileBackedVector();
+    TestVectorIo();
+    TestSimdAlgorithms();
+    TestInstrumentation();
+    TestBatchInsert();
+    TestParallelAlgorithms();
+    TestConcurrentSimpleVector();
+    TestSoaVector();
+    TestCowSimpleVector();
+    TestSegmentedVector();
+    TestGapBuffer();
+    TestStaticVector();
+    TestFlatContainers();
+    TestCheckedIterators();
+    TestPackedVector();
+    TestPipeline();
     return 0;
 }
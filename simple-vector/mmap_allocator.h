@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Аллокатор для очень больших векторов (Linux/POSIX).
+// Каждое выделение резервирует непрерывный диапазон виртуальных адресов размером
+// не меньше reserve_bytes без физической памяти (PROT_NONE, MAP_NORESERVE) и
+// открывает доступ только к запрошенной части. Ядро выделяет страницы при первом обращении.
+// Рост внутри резерва выполняется через expand(): доступ открывается к следующим страницам,
+// элементы не копируются, адрес массива не меняется. ArrayPtr и SimpleVector пользуются
+// expand() автоматически, если аллокатор его предоставляет.
+// Диапазон выравнивается по 2 МиБ и помечается MADV_HUGEPAGE, чтобы ядро могло
+// отобразить его большими страницами и снизить число промахов TLB
+template <typename Type>
+class MmapAllocator {
+public:
+    using value_type = Type;
+
+    static constexpr size_t DEFAULT_RESERVE_BYTES = size_t{64} << 30;  // 64 ГиБ адресов
+    static constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+
+    explicit MmapAllocator(size_t reserve_bytes = DEFAULT_RESERVE_BYTES) noexcept
+    : reserve_bytes_(reserve_bytes) {
+    }
+
+    template <typename Other>
+    MmapAllocator(const MmapAllocator<Other>& other) noexcept
+    : reserve_bytes_(other.GetReserveBytes()) {
+    }
+
+    Type* allocate(size_t n) {
+        const size_t reserved = ReservedBytes(n);
+        // Резервируем с запасом на выравнивание по границе большой страницы и обрезаем края
+        const size_t mapped = reserved + HUGE_PAGE_SIZE;
+        void* raw = ::mmap(nullptr, mapped, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(raw);
+        const std::uintptr_t aligned = (begin + HUGE_PAGE_SIZE - 1) & ~(std::uintptr_t{HUGE_PAGE_SIZE} - 1);
+        if (aligned != begin) {
+            ::munmap(raw, aligned - begin);
+        }
+        const size_t tail = mapped - (aligned - begin) - reserved;
+        if (tail != 0) {
+            ::munmap(reinterpret_cast<void*>(aligned + reserved), tail);
+        }
+        void* ptr = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        ::madvise(ptr, reserved, MADV_HUGEPAGE);
+#endif
+        if (::mprotect(ptr, CommittedBytes(n), PROT_READ | PROT_WRITE) != 0) {
+            ::munmap(ptr, reserved);
+            throw std::bad_alloc();
+        }
+        return static_cast<Type*>(ptr);
+    }
+
+    void deallocate(Type* ptr, size_t n) noexcept {
+        ::munmap(ptr, ReservedBytes(n));
+    }
+
+    // Расширяет блок ptr с old_n до new_n элементов на месте.
+    // Возвращает false, если new_n не помещается в зарезервированный диапазон
+    bool expand(Type* ptr, size_t old_n, size_t new_n) noexcept {
+        const size_t reserved = ReservedBytes(old_n);
+        const size_t old_committed = CommittedBytes(old_n);
+        const size_t new_committed = CommittedBytes(new_n);
+        if (new_committed > reserved) {
+            return false;
+        }
+        if (new_committed > old_committed) {
+            char* base = reinterpret_cast<char*>(ptr);
+            if (::mprotect(base + old_committed, new_committed - old_committed, PROT_READ | PROT_WRITE) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t GetReserveBytes() const noexcept {
+        return reserve_bytes_;
+    }
+
+private:
+    static size_t PageSize() noexcept {
+        static const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return page_size;
+    }
+
+    static size_t RoundToPages(size_t bytes) noexcept {
+        const size_t page = PageSize();
+        return (bytes + page - 1) / page * page;
+    }
+
+    // Размер открытой для чтения и записи части блока из n элементов
+    static size_t CommittedBytes(size_t n) noexcept {
+        return RoundToPages(n * sizeof(Type));
+    }
+
+    // Размер зарезервированного диапазона. Зависит только от n и reserve_bytes_,
+    // поэтому deallocate и expand восстанавливают его без дополнительного состояния
+    size_t ReservedBytes(size_t n) const noexcept {
+        return std::max(CommittedBytes(n), RoundToPages(reserve_bytes_));
+    }
+
+    size_t reserve_bytes_;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const MmapAllocator<Lhs>& lhs, const MmapAllocator<Rhs>& rhs) noexcept {
+    return lhs.GetReserveBytes() == rhs.GetReserveBytes();
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!=(const MmapAllocator<Lhs>& lhs, const MmapAllocator<Rhs>& rhs) noexcept {
+    return !(lhs == rhs);
+}
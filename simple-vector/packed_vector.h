@@ -0,0 +1,616 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "simd_algorithms.h"
+#include "simple_vector.h"
+
+// Ядра распаковки блока PackedVector: BLOCK_SIZE значений по width бит подряд в словах uint64_t,
+// к каждому прибавляется reference. words должен быть доступен ещё на одно слово за последним
+// словом блока (PackedVector держит в конце слово-заглушку)
+namespace packed {
+
+inline constexpr size_t BLOCK_SIZE = 128;
+
+inline constexpr std::uint64_t WidthMask(unsigned width) noexcept {
+    return width == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << width) - 1;
+}
+
+// Значение с номером index из последовательности полей по width бит
+inline std::uint64_t ExtractBits(const std::uint64_t* words, size_t index, unsigned width) noexcept {
+    const size_t bit = index * width;
+    const size_t word = bit / 64;
+    const unsigned shift = bit % 64;
+    std::uint64_t value = words[word] >> shift;
+    if (shift + width > 64) {
+        value |= words[word + 1] << (64 - shift);
+    }
+    return value & WidthMask(width);
+}
+
+// Записывает value в поле с номером index, не трогая соседние поля
+inline void StoreBits(std::uint64_t* words, size_t index, unsigned width, std::uint64_t value) noexcept {
+    const size_t bit = index * width;
+    const size_t word = bit / 64;
+    const unsigned shift = bit % 64;
+    const std::uint64_t mask = WidthMask(width);
+    words[word] = (words[word] & ~(mask << shift)) | (value << shift);
+    if (shift + width > 64) {
+        words[word + 1] = (words[word + 1] & ~(mask >> (64 - shift))) | (value >> (64 - shift));
+    }
+}
+
+namespace scalar {
+
+template <typename T>
+void UnpackBlock(const std::uint64_t* words, unsigned width, std::uint64_t reference, T* out) noexcept {
+    for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        out[i] = static_cast<T>(reference + ExtractBits(words, i, width));
+    }
+}
+
+}  // namespace scalar
+
+#ifdef SIMPLE_VECTOR_X86_SIMD
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+// Четыре значения за шаг: номера слов и сдвиги считаются в 64-битных дорожках,
+// оба слова поля собираются gather, сдвиги — переменные (srlv/sllv).
+// Сдвиг влево на 64 даёт 0, поэтому поле, целиком лежащее в одном слове, ветвлений не требует
+template <typename T>
+void UnpackBlock(const std::uint64_t* words, unsigned width, std::uint64_t reference, T* out) noexcept {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+    const long long* base = reinterpret_cast<const long long*>(words);
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(WidthMask(width)));
+    const __m256i ref = _mm256_set1_epi64x(static_cast<long long>(reference));
+    const __m256i step = _mm256_set1_epi64x(4 * static_cast<long long>(width));
+    const __m256i low_bits = _mm256_set1_epi64x(63);
+    const __m256i word_bits = _mm256_set1_epi64x(64);
+    __m256i bits = _mm256_set_epi64x(3 * width, 2 * width, width, 0);
+    for (size_t i = 0; i < BLOCK_SIZE; i += 4) {
+        const __m256i word = _mm256_srli_epi64(bits, 6);
+        const __m256i shift = _mm256_and_si256(bits, low_bits);
+        const __m256i lo = _mm256_i64gather_epi64(base, word, 8);
+        const __m256i hi = _mm256_i64gather_epi64(base + 1, word, 8);
+        __m256i value = _mm256_or_si256(_mm256_srlv_epi64(lo, shift),
+                                        _mm256_sllv_epi64(hi, _mm256_sub_epi64(word_bits, shift)));
+        value = _mm256_add_epi64(_mm256_and_si256(value, mask), ref);
+        if constexpr (sizeof(T) == 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+        } else {
+            // Младшие половины четырёх дорожек — в младшие 128 бит
+            const __m256i packed = _mm256_permutevar8x32_epi32(value, _mm256_set_epi32(0, 0, 0, 0, 6, 4, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_castsi256_si128(packed));
+        }
+        bits = _mm256_add_epi64(bits, step);
+    }
+}
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#endif  // SIMPLE_VECTOR_X86_SIMD
+
+// Распаковывает блок набором инструкций, выбранным в simd::GetSimdLevel()
+template <typename T>
+void UnpackBlock(const std::uint64_t* words, unsigned width, std::uint64_t reference, T* out) noexcept {
+    if (width == 0) {
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            out[i] = static_cast<T>(reference);
+        }
+        return;
+    }
+#ifdef SIMPLE_VECTOR_X86_SIMD
+    if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+        if (simd::GetSimdLevel() == simd::SimdLevel::AVX2) {
+            avx2::UnpackBlock(words, width, reference, out);
+            return;
+        }
+    }
+#endif
+    scalar::UnpackBlock(words, width, reference, out);
+}
+
+}  // namespace packed
+
+// Вектор целых чисел в сжатом виде. Элементы хранятся блоками по packed::BLOCK_SIZE (128):
+// у блока есть опорное значение — минимум блока — и ширина, а каждый элемент хранится как
+// разность с опорным значением в width битах, где width — число бит разности максимума и минимума.
+// Блок из маленьких чисел или из почти монотонной последовательности (идентификаторы, метки времени)
+// занимает единицы бит на элемент вместо 32 или 64. Доступ по индексу — O(1): сдвиг, маска, сложение.
+// Последний неполный блок хранится несжатым, PushBack в него — запись в массив, заполненный блок
+// сжимается за O(BLOCK_SIZE). Распаковка целых блоков (Unpack, ForEach) использует AVX2,
+// если он есть.
+// Элементы не лежат в памяти по отдельности, поэтому ссылок на них нет: operator[] возвращает
+// значение, записывает Set. Если новое значение не помещается в диапазон блока, блок
+// перепаковывается с большей шириной, а освободившиеся слова собираются, когда их станет
+// больше половины
+template <typename T>
+class PackedVector {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "PackedVector stores integers");
+
+    using Unsigned = std::make_unsigned_t<T>;
+
+    // Заголовок блока — 16 байт, по биту на элемент
+    struct Block {
+        std::uint64_t reference = 0;
+        std::uint64_t offset : 56;  // первое слово блока в words_
+        std::uint64_t width : 8;
+    };
+
+public:
+    class ConstIterator;
+    using Iterator = ConstIterator;
+    using value_type = T;
+
+    static constexpr size_t BLOCK_SIZE = packed::BLOCK_SIZE;
+
+    PackedVector() noexcept = default;
+
+    explicit PackedVector(size_t size, T value = T{})
+    : PackedVector() {
+        Resize(size, value);
+    }
+
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    PackedVector(InputIt first, InputIt last)
+    : PackedVector() {
+        for (; first != last; ++first) {
+            PushBack(*first);
+        }
+    }
+
+    PackedVector(std::initializer_list<T> init)
+    : PackedVector(init.begin(), init.end()) {
+    }
+
+    PackedVector(const PackedVector& other) = default;
+
+    PackedVector(PackedVector&& other) noexcept
+    : blocks_(std::move(other.blocks_)),
+      words_(std::move(other.words_)),
+      tail_(std::move(other.tail_)),
+      garbage_words_(std::exchange(other.garbage_words_, 0)) {
+    }
+
+    PackedVector& operator=(const PackedVector& rhs) = default;
+
+    PackedVector& operator=(PackedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            PackedVector tmp(std::move(rhs));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    size_t GetSize() const noexcept {
+        return blocks_.GetSize() * BLOCK_SIZE + tail_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Байты памяти, занятые вектором: слова, заголовки блоков и несжатый хвост
+    size_t GetAllocatedBytes() const noexcept {
+        return words_.GetCapacity() * sizeof(std::uint64_t) + blocks_.GetCapacity() * sizeof(Block)
+            + tail_.GetCapacity() * sizeof(T);
+    }
+
+    // Средняя ширина сжатых блоков в битах на элемент
+    double GetBitsPerValue() const noexcept {
+        if (blocks_.IsEmpty()) {
+            return 0;
+        }
+        size_t total = 0;
+        for (const Block& block : blocks_) {
+            total += block.width;
+        }
+        return static_cast<double>(total) / static_cast<double>(blocks_.GetSize());
+    }
+
+    T operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < GetSize(), "PackedVector index is out of range");
+        const size_t block_index = index / BLOCK_SIZE;
+        if (block_index == blocks_.GetSize()) {
+            return tail_[index % BLOCK_SIZE];
+        }
+        const Block& block = blocks_[block_index];
+        return Decode(block.reference, packed::ExtractBits(words_.GetData() + block.offset, index % BLOCK_SIZE, block.width));
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    T At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    // Записывает value в элемент index. Если value не помещается в диапазон блока,
+    // блок перепаковывается за O(BLOCK_SIZE)
+    void Set(size_t index, T value) {
+        SIMPLE_VECTOR_CHECK(index < GetSize(), "PackedVector index is out of range");
+        const size_t block_index = index / BLOCK_SIZE;
+        if (block_index == blocks_.GetSize()) {
+            tail_[index % BLOCK_SIZE] = value;
+            return;
+        }
+        Block& block = blocks_[block_index];
+        // Разность считается в ширине T: у знакового T с отрицательным опорным значением
+        // разность расширенных до 64 бит значений заняла бы старшие биты
+        const std::uint64_t delta =
+            static_cast<Unsigned>(static_cast<Unsigned>(value) - static_cast<Unsigned>(block.reference));
+        if (Fits(value, block) && (delta & ~packed::WidthMask(block.width)) == 0) {
+            packed::StoreBits(words_.GetData() + block.offset, index % BLOCK_SIZE, block.width, delta);
+            return;
+        }
+        T values[BLOCK_SIZE];
+        UnpackBlock(block, values);
+        values[index % BLOCK_SIZE] = value;
+        const Block old_block = block;
+        block = Pack(values);
+        if (WordsOf(block) <= WordsOf(old_block)) {
+            // Перепакованный блок не длиннее прежнего и переезжает на его место
+            std::copy_n(words_.GetData() + block.offset, WordsOf(block), words_.GetData() + old_block.offset);
+            DropWordsFrom(block.offset);
+            block.offset = old_block.offset;
+            garbage_words_ += WordsOf(old_block) - WordsOf(block);
+        } else {
+            garbage_words_ += WordsOf(old_block);
+        }
+        MaybeCompact();
+    }
+
+    void PushBack(T value) {
+        if (tail_.GetCapacity() == 0) {
+            tail_.Reserve(BLOCK_SIZE);
+        }
+        tail_.PushBack(value);
+        if (tail_.GetSize() == BLOCK_SIZE) {
+            try {
+                SealTail();
+            } catch (...) {
+                tail_.PopBack();
+                throw;
+            }
+        }
+    }
+
+    // Удаляет последний элемент. Если хвост пуст, последний блок распаковывается в хвост
+    void PopBack() {
+        if (IsEmpty()) {
+            return;
+        }
+        if (tail_.IsEmpty()) {
+            UnsealLastBlock();
+        }
+        tail_.PopBack();
+    }
+
+    void Resize(size_t new_size, T value = T{}) {
+        while (blocks_.GetSize() * BLOCK_SIZE > new_size) {
+            UnsealLastBlock();
+        }
+        if (new_size < GetSize()) {
+            tail_.Resize(new_size % BLOCK_SIZE);
+            return;
+        }
+        while (GetSize() < new_size) {
+            PushBack(value);
+        }
+    }
+
+    // Отдаёт лишнюю вместимость слов и заголовков, собирая слова перепакованных блоков
+    void ShrinkToFit() {
+        if (garbage_words_ != 0) {
+            Compact();
+        }
+        words_.ShrinkToFit();
+        blocks_.ShrinkToFit();
+        if (tail_.IsEmpty()) {
+            tail_.ShrinkToFit();
+        }
+    }
+
+    void Clear() noexcept {
+        blocks_.Clear();
+        tail_.Clear();
+        words_.Clear();
+        garbage_words_ = 0;
+    }
+
+    // Распаковывает count элементов начиная с first в out. Целые блоки распаковываются SIMD
+    void Unpack(size_t first, size_t count, T* out) const {
+        SIMPLE_VECTOR_CHECK(first + count <= GetSize(), "PackedVector range is out of range");
+        T buffer[BLOCK_SIZE];
+        while (count > 0) {
+            const size_t block_index = first / BLOCK_SIZE;
+            const size_t in_block = first % BLOCK_SIZE;
+            const size_t n = std::min(count, BLOCK_SIZE - in_block);
+            if (block_index == blocks_.GetSize()) {
+                std::copy_n(tail_.GetData() + in_block, n, out);
+            } else if (n == BLOCK_SIZE) {
+                UnpackBlock(blocks_[block_index], out);
+            } else {
+                UnpackBlock(blocks_[block_index], buffer);
+                std::copy_n(buffer + in_block, n, out);
+            }
+            first += n;
+            count -= n;
+            out += n;
+        }
+    }
+
+    // Вызывает fn(value) для каждого элемента по порядку, распаковывая вектор по блоку
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+        T buffer[BLOCK_SIZE];
+        for (const Block& block : blocks_) {
+            UnpackBlock(block, buffer);
+            for (const T value : buffer) {
+                fn(value);
+            }
+        }
+        for (const T value : tail_) {
+            fn(value);
+        }
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    void swap(PackedVector& other) noexcept {
+        blocks_.swap(other.blocks_);
+        words_.swap(other.words_);
+        tail_.swap(other.tail_);
+        std::swap(garbage_words_, other.garbage_words_);
+    }
+
+    friend bool operator==(const PackedVector& lhs, const PackedVector& rhs) {
+        if (lhs.GetSize() != rhs.GetSize()) {
+            return false;
+        }
+        for (size_t i = 0; i < lhs.GetSize(); ++i) {
+            if (lhs[i] != rhs[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const PackedVector& lhs, const PackedVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Значение элемента как беззнаковое: разность с опорным значением не переполняется
+    static std::uint64_t Encode(T value) noexcept {
+        return static_cast<Unsigned>(value);
+    }
+
+    static T Decode(std::uint64_t reference, std::uint64_t delta) noexcept {
+        return static_cast<T>(static_cast<Unsigned>(reference + delta));
+    }
+
+    static size_t WordsOf(const Block& block) noexcept {
+        return BLOCK_SIZE * block.width / 64;
+    }
+
+    // Не меньше ли value опорного значения блока
+    static bool Fits(T value, const Block& block) noexcept {
+        return !(value < Decode(block.reference, 0));
+    }
+
+    void UnpackBlock(const Block& block, T* out) const noexcept {
+        packed::UnpackBlock(words_.GetData() + block.offset, block.width, block.reference, out);
+    }
+
+    // Сжимает BLOCK_SIZE значений в новые слова в конце words_ перед словом-заглушкой
+    Block Pack(const T* values) {
+        T min = values[0];
+        T max = values[0];
+        for (size_t i = 1; i < BLOCK_SIZE; ++i) {
+            min = values[i] < min ? values[i] : min;
+            max = max < values[i] ? values[i] : max;
+        }
+        Block block{};
+        block.reference = Encode(min);
+        const std::uint64_t range = static_cast<Unsigned>(static_cast<Unsigned>(max) - static_cast<Unsigned>(min));
+        block.width = range == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(range));
+        if (words_.IsEmpty()) {
+            words_.Resize(1);
+        }
+        block.offset = words_.GetSize() - 1;
+        words_.Resize(words_.GetSize() + WordsOf(block));
+        std::uint64_t* words = words_.GetData() + block.offset;
+        std::fill(words, words + WordsOf(block) + 1, 0);
+        for (size_t i = 0; i < BLOCK_SIZE && block.width != 0; ++i) {
+            packed::StoreBits(words, i, block.width, Encode(values[i]) - block.reference);
+        }
+        return block;
+    }
+
+    // Отрезает слова начиная с offset и ставит на его место слово-заглушку
+    void DropWordsFrom(size_t offset) noexcept {
+        words_.Resize(offset + 1);
+        words_[offset] = 0;
+    }
+
+    // Сжимает заполненный хвост в блок. При исключении вектор не меняется
+    void SealTail() {
+        const Block block = Pack(tail_.GetData());
+        try {
+            blocks_.PushBack(block);
+        } catch (...) {
+            DropWordsFrom(block.offset);
+            throw;
+        }
+        tail_.Clear();
+    }
+
+    // Распаковывает последний блок в пустой хвост и освобождает его слова
+    void UnsealLastBlock() {
+        const Block block = blocks_[blocks_.GetSize() - 1];
+        tail_.Resize(BLOCK_SIZE);
+        UnpackBlock(block, tail_.GetData());
+        blocks_.PopBack();
+        if (block.offset + WordsOf(block) + 1 == words_.GetSize()) {
+            DropWordsFrom(block.offset);
+        } else {
+            garbage_words_ += WordsOf(block);
+            MaybeCompact();
+        }
+    }
+
+    // Переписывает блоки подряд, когда слов перепакованных блоков больше половины
+    void MaybeCompact() {
+        if (garbage_words_ * 2 > words_.GetSize()) {
+            Compact();
+        }
+    }
+
+    // Переписывает слова блоков подряд без слов перепакованных блоков
+    void Compact() {
+        SimpleVector<std::uint64_t> words(Reserve(words_.GetSize() - garbage_words_));
+        for (Block& block : blocks_) {
+            const size_t offset = words.GetSize();
+            words.Append(words_.GetData() + block.offset, words_.GetData() + block.offset + WordsOf(block));
+            block.offset = offset;
+        }
+        words.PushBack(0);
+        words_.swap(words);
+        garbage_words_ = 0;
+    }
+
+    SimpleVector<Block> blocks_;
+    SimpleVector<std::uint64_t> words_;  // слова блоков и слово-заглушка в конце; пуст, пока блоков нет
+    SimpleVector<T> tail_;
+    size_t garbage_words_ = 0;
+};
+
+// Итератор только для чтения: разыменование возвращает значение, как у std::vector<bool>
+template <typename T>
+class PackedVector<T>::ConstIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = T;
+
+    ConstIterator() noexcept = default;
+
+    ConstIterator(const PackedVector* owner, size_t index) noexcept
+    : owner_(owner), index_(index) {
+    }
+
+    T operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+
+    T operator[](difference_type n) const noexcept {
+        return (*owner_)[index_ + n];
+    }
+
+    ConstIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    ConstIterator operator++(int) noexcept {
+        ConstIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    ConstIterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+
+    ConstIterator operator--(int) noexcept {
+        ConstIterator old = *this;
+        --index_;
+        return old;
+    }
+
+    ConstIterator& operator+=(difference_type n) noexcept {
+        index_ += n;
+        return *this;
+    }
+
+    ConstIterator& operator-=(difference_type n) noexcept {
+        index_ -= n;
+        return *this;
+    }
+
+    friend ConstIterator operator+(ConstIterator it, difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend ConstIterator operator+(difference_type n, ConstIterator it) noexcept {
+        return it += n;
+    }
+
+    friend ConstIterator operator-(ConstIterator it, difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend difference_type operator-(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+
+    friend bool operator<(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend bool operator>(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const ConstIterator& lhs, const ConstIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    const PackedVector* owner_ = nullptr;
+    size_t index_ = 0;
+};
@@ -0,0 +1,505 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "simple_vector.h"
+
+// Параллельные алгоритмы над диапазонами и SimpleVector: ForEach, Transform, Reduce, Sort, Fill, Copy.
+// Работа делится на куски, границы которых (кроме крайних) выровнены по кэш-линии,
+// чтобы потоки не писали в одну линию. Куски раздаются потокам ThreadPool динамически,
+// вызывающий поток работает вместе с пулом. Маленькие диапазоны обрабатываются без потоков
+namespace parallel {
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+// Кусок меньше этого числа байт не стоит отдавать другому потоку
+inline constexpr size_t MIN_CHUNK_BYTES = 16 * 1024;
+
+// Пул потоков с очередью задач у каждого потока. Поток берёт задачи из конца своей очереди,
+// а опустев, крадёт из начала чужих. Вызывающий поток может помогать пулу через RunPendingTask,
+// поэтому ожидание внутри задачи пула не приводит к взаимной блокировке
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads — общее число потоков вместе с вызывающим: пул запускает threads - 1 рабочих
+    explicit ThreadPool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency()))
+    : queues_(std::max<size_t>(threads, 1)) {
+        for (auto& queue : queues_) {
+            queue = std::make_unique<WorkerQueue>();
+        }
+        for (size_t i = 1; i < queues_.size(); ++i) {
+            workers_.emplace_back([this, i] {
+                WorkerLoop(i);
+            });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Дожидается выполнения всех поставленных задач и останавливает потоки
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    size_t GetThreadCount() const noexcept {
+        return queues_.size();
+    }
+
+    // Ставит задачу в очередь. Из рабочего потока — в его собственную очередь,
+    // иначе — в очереди по кругу. Пул без рабочих потоков выполняет задачу сразу
+    void Submit(Task task) {
+        if (workers_.empty()) {
+            task();
+            return;
+        }
+        const size_t index = current_.pool == this ? current_.index
+                                                   : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard<std::mutex> guard(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleep_mutex_);
+            pending_.fetch_add(1, std::memory_order_relaxed);
+        }
+        wake_.notify_one();
+    }
+
+    // Выполняет одну ожидающую задачу в текущем потоке. Возвращает false, если задач нет
+    bool RunPendingTask() {
+        Task task;
+        if (!TakeTask(current_.pool == this ? current_.index : 0, task)) {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Пул и номер очереди текущего рабочего потока
+    struct WorkerContext {
+        const ThreadPool* pool;
+        size_t index;
+    };
+
+    void WorkerLoop(size_t index) {
+        current_ = {this, index};
+        Task task;
+        while (true) {
+            if (TakeTask(index, task)) {
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this] {
+                return stop_ || pending_.load(std::memory_order_relaxed) > 0;
+            });
+            if (stop_ && pending_.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+        }
+    }
+
+    // Берёт задачу из конца своей очереди, иначе крадёт из начала чужой
+    bool TakeTask(size_t index, Task& task) {
+        {
+            WorkerQueue& own = *queues_[index];
+            std::lock_guard<std::mutex> guard(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            WorkerQueue& victim = *queues_[(index + offset) % queues_.size()];
+            std::lock_guard<std::mutex> guard(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Очередь 0 принадлежит внешним потокам, очереди 1..n-1 — рабочим
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> next_queue_{0};
+    std::atomic<size_t> pending_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    inline static thread_local WorkerContext current_{nullptr, 0};
+};
+
+// Пул по умолчанию: по потоку на ядро
+inline ThreadPool& DefaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// Разбиение [0, count) на куски для thread_count потоков. Границы кусков, кроме первой
+// и последней, приходятся на начало кэш-линии в массиве base из элементов размера element_size
+class ChunkPlan {
+public:
+    ChunkPlan(const void* base, size_t element_size, size_t count, size_t thread_count)
+    : count_(count) {
+        // Через каждые period элементов адрес возвращается к тому же смещению внутри линии
+        const size_t period = CACHE_LINE_SIZE / std::gcd(element_size, CACHE_LINE_SIZE);
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(base);
+        for (size_t i = 0; i < period; ++i) {
+            if ((address + i * element_size) % CACHE_LINE_SIZE == 0) {
+                head_ = i;
+                break;
+            }
+        }
+        const size_t min_chunk = std::max<size_t>(1, MIN_CHUNK_BYTES / std::max<size_t>(element_size, 1));
+        // Несколько кусков на поток сглаживают неравномерную нагрузку
+        const size_t balanced = (count + thread_count * 4 - 1) / (thread_count * 4);
+        chunk_ = std::max(min_chunk, balanced);
+        chunk_ = (chunk_ + period - 1) / period * period;
+    }
+
+    size_t GetChunkCount() const noexcept {
+        if (count_ <= head_ + chunk_) {
+            return count_ == 0 ? 0 : 1;
+        }
+        return 1 + (count_ - head_ - chunk_ + chunk_ - 1) / chunk_;
+    }
+
+    // Границы куска k: [first, second)
+    std::pair<size_t, size_t> GetChunk(size_t k) const noexcept {
+        const size_t begin = k == 0 ? 0 : head_ + k * chunk_;
+        return {begin, std::min(count_, head_ + (k + 1) * chunk_)};
+    }
+
+private:
+    size_t count_;
+    size_t head_ = 0;
+    size_t chunk_ = 1;
+};
+
+// Вызывает task(k) для k из [0, task_count) на потоках пула. Задачи раздаются динамически,
+// вызывающий поток участвует в работе. После первого исключения оставшиеся задачи
+// пропускаются, а исключение пробрасывается, когда все потоки закончат
+template <typename TaskFn>
+void ParallelFor(ThreadPool& pool, size_t task_count, TaskFn task) {
+    const size_t helpers = std::min(pool.GetThreadCount(), task_count);
+    if (helpers <= 1) {
+        for (size_t k = 0; k < task_count; ++k) {
+            task(k);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> finished{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto work = [&] {
+        for (size_t k = next.fetch_add(1, std::memory_order_relaxed);
+             k < task_count && !failed.load(std::memory_order_relaxed);
+             k = next.fetch_add(1, std::memory_order_relaxed)) {
+            try {
+                task(k);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+    for (size_t i = 1; i < helpers; ++i) {
+        pool.Submit([&] {
+            work();
+            finished.fetch_add(1, std::memory_order_release);
+        });
+    }
+    work();
+    // Задачи ссылаются на локальные переменные: ждём их все, помогая пулу
+    while (finished.load(std::memory_order_acquire) != helpers - 1) {
+        if (!pool.RunPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Вызывает body(k, begin, end) для каждого куска плана
+template <typename Body>
+void ForEachChunk(ThreadPool& pool, const ChunkPlan& plan, Body body) {
+    ParallelFor(pool, plan.GetChunkCount(), [&plan, &body](size_t k) {
+        const auto [begin, end] = plan.GetChunk(k);
+        body(k, begin, end);
+    });
+}
+
+template <typename Iterator, typename = void>
+struct IsRandomAccessIterator : std::false_type {
+};
+
+template <typename Iterator>
+struct IsRandomAccessIterator<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>>
+    : std::is_convertible<typename std::iterator_traits<Iterator>::iterator_category,
+                          std::random_access_iterator_tag> {
+};
+
+template <typename Iterator>
+inline constexpr bool IsRandomAccessIteratorV = IsRandomAccessIterator<Iterator>::value;
+
+template <typename Iterator>
+using EnableIfRandomAccess = std::enable_if_t<IsRandomAccessIteratorV<Iterator>>;
+
+template <typename Iterator>
+ChunkPlan MakePlan(ThreadPool& pool, Iterator first, size_t count) {
+    const void* base = count == 0 ? nullptr : static_cast<const void*>(std::addressof(*first));
+    return ChunkPlan(base, sizeof(typename std::iterator_traits<Iterator>::value_type), count, pool.GetThreadCount());
+}
+
+// Вызывает fn(element) для каждого элемента [first, last)
+template <typename RandomIt, typename Fn, typename = EnableIfRandomAccess<RandomIt>>
+void ForEach(RandomIt first, RandomIt last, Fn fn, ThreadPool& pool = DefaultThreadPool()) {
+    const size_t count = static_cast<size_t>(last - first);
+    ForEachChunk(pool, MakePlan(pool, first, count), [first, &fn](size_t, size_t begin, size_t end) {
+        std::for_each(first + begin, first + end, fn);
+    });
+}
+
+// Записывает fn(first[i]) в dest[i]. Память dest должна содержать живые элементы
+template <typename RandomIt, typename OutputIt, typename Fn, typename = EnableIfRandomAccess<RandomIt>,
+          typename = EnableIfRandomAccess<OutputIt>>
+void Transform(RandomIt first, RandomIt last, OutputIt dest, Fn fn, ThreadPool& pool = DefaultThreadPool()) {
+    const size_t count = static_cast<size_t>(last - first);
+    ForEachChunk(pool, MakePlan(pool, dest, count), [first, dest, &fn](size_t, size_t begin, size_t end) {
+        std::transform(first + begin, first + end, dest + begin, fn);
+    });
+}
+
+// Копирует [first, last) в dest присваиванием
+template <typename RandomIt, typename OutputIt, typename = EnableIfRandomAccess<RandomIt>,
+          typename = EnableIfRandomAccess<OutputIt>>
+void Copy(RandomIt first, RandomIt last, OutputIt dest, ThreadPool& pool = DefaultThreadPool()) {
+    const size_t count = static_cast<size_t>(last - first);
+    ForEachChunk(pool, MakePlan(pool, dest, count), [first, dest](size_t, size_t begin, size_t end) {
+        std::copy(first + begin, first + end, dest + begin);
+    });
+}
+
+template <typename RandomIt, typename T, typename = EnableIfRandomAccess<RandomIt>>
+void Fill(RandomIt first, RandomIt last, const T& value, ThreadPool& pool = DefaultThreadPool()) {
+    const size_t count = static_cast<size_t>(last - first);
+    ForEachChunk(pool, MakePlan(pool, first, count), [first, &value](size_t, size_t begin, size_t end) {
+        std::fill(first + begin, first + end, value);
+    });
+}
+
+// Свёртка [first, last) ассоциативной операцией op. Каждый кусок сворачивается отдельно,
+// затем частичные результаты сворачиваются с init слева направо
+template <typename RandomIt, typename T, typename BinaryOp = std::plus<>, typename = EnableIfRandomAccess<RandomIt>>
+T Reduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(), ThreadPool& pool = DefaultThreadPool()) {
+    const size_t count = static_cast<size_t>(last - first);
+    const ChunkPlan plan = MakePlan(pool, first, count);
+    std::vector<std::optional<T>> partials(plan.GetChunkCount());
+    ForEachChunk(pool, plan, [first, &op, &partials](size_t k, size_t begin, size_t end) {
+        T acc = first[begin];
+        for (size_t i = begin + 1; i < end; ++i) {
+            acc = op(std::move(acc), first[i]);
+        }
+        partials[k].emplace(std::move(acc));
+    });
+    for (std::optional<T>& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+// Сортировка слиянием: куски сортируются параллельно, затем соседние пары сливаются
+// параллельно, пока не останется один кусок. Последние слияния выполняются меньшим числом потоков
+template <typename RandomIt, typename Compare = std::less<>, typename = EnableIfRandomAccess<RandomIt>>
+void Sort(RandomIt first, RandomIt last, Compare comp = Compare(), ThreadPool& pool = DefaultThreadPool()) {
+    const size_t count = static_cast<size_t>(last - first);
+    const ChunkPlan plan = MakePlan(pool, first, count);
+    if (pool.GetThreadCount() == 1 || plan.GetChunkCount() <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+    std::vector<size_t> bounds;
+    for (size_t k = 0; k < plan.GetChunkCount(); ++k) {
+        bounds.push_back(plan.GetChunk(k).first);
+    }
+    bounds.push_back(count);
+    ForEachChunk(pool, plan, [first, &comp](size_t, size_t begin, size_t end) {
+        std::sort(first + begin, first + end, comp);
+    });
+    while (bounds.size() > 2) {
+        const size_t merges = (bounds.size() - 1) / 2;
+        ParallelFor(pool, merges, [first, &comp, &bounds](size_t i) {
+            std::inplace_merge(first + bounds[2 * i], first + bounds[2 * i + 1], first + bounds[2 * i + 2], comp);
+        });
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != count) {
+            merged.push_back(count);
+        }
+        bounds = std::move(merged);
+    }
+}
+
+// Дописывает в конец вектора count элементов, создавая i-й вызовом
+// construct(alloc, place, i) параллельно. Если какой-то элемент бросит исключение,
+// созданные элементы разрушаются, а размер вектора не меняется
+template <typename Type, typename... Params, typename ConstructFn>
+void AppendParallel(SimpleVector<Type, Params...>& v, size_t count, ConstructFn construct,
+                    ThreadPool& pool = DefaultThreadPool()) {
+    using Allocator = typename SimpleVector<Type, Params...>::AllocatorType;
+    using Traits = std::allocator_traits<Allocator>;
+    const Allocator alloc = v.GetAllocator();
+    v.AppendWith(count, [&](Type* dest, size_t n) {
+        const ChunkPlan plan(dest, sizeof(Type), n, pool.GetThreadCount());
+        std::vector<unsigned char> done(plan.GetChunkCount(), 0);
+        try {
+            ForEachChunk(pool, plan, [&](size_t k, size_t begin, size_t end) {
+                Allocator chunk_alloc(alloc);
+                size_t i = begin;
+                try {
+                    for (; i < end; ++i) {
+                        construct(chunk_alloc, dest + i, i);
+                    }
+                } catch (...) {
+                    for (size_t j = begin; j < i; ++j) {
+                        Traits::destroy(chunk_alloc, dest + j);
+                    }
+                    throw;
+                }
+                done[k] = 1;
+            });
+        } catch (...) {
+            Allocator cleanup_alloc(alloc);
+            for (size_t k = 0; k < done.size(); ++k) {
+                if (done[k]) {
+                    const auto [begin, end] = plan.GetChunk(k);
+                    for (size_t j = begin; j < end; ++j) {
+                        Traits::destroy(cleanup_alloc, dest + j);
+                    }
+                }
+            }
+            throw;
+        }
+    });
+}
+
+// Варианты для SimpleVector
+
+template <typename Type, typename... Params, typename Fn>
+void ForEach(SimpleVector<Type, Params...>& v, Fn fn, ThreadPool& pool = DefaultThreadPool()) {
+    ForEach(v.begin(), v.end(), std::move(fn), pool);
+}
+
+template <typename Type, typename... Params>
+void Fill(SimpleVector<Type, Params...>& v, const Type& value, ThreadPool& pool = DefaultThreadPool()) {
+    Fill(v.begin(), v.end(), value, pool);
+}
+
+template <typename Type, typename... Params, typename T, typename BinaryOp = std::plus<>>
+T Reduce(const SimpleVector<Type, Params...>& v, T init, BinaryOp op = BinaryOp(),
+         ThreadPool& pool = DefaultThreadPool()) {
+    return Reduce(v.begin(), v.end(), std::move(init), std::move(op), pool);
+}
+
+template <typename Type, typename... Params, typename Compare = std::less<>>
+void Sort(SimpleVector<Type, Params...>& v, Compare comp = Compare(), ThreadPool& pool = DefaultThreadPool()) {
+    Sort(v.begin(), v.end(), std::move(comp), pool);
+}
+
+// Заменяет содержимое out результатами fn(in[i]); элементы out создаются параллельно.
+// Если in и out — один вектор, элементы заменяются на месте присваиванием
+template <typename In, typename... InParams, typename Out, typename... OutParams, typename Fn>
+void Transform(const SimpleVector<In, InParams...>& in, SimpleVector<Out, OutParams...>& out, Fn fn,
+               ThreadPool& pool = DefaultThreadPool()) {
+    if constexpr (std::is_same_v<SimpleVector<In, InParams...>, SimpleVector<Out, OutParams...>>) {
+        if (&in == &out) {
+            Transform(out.begin(), out.end(), out.begin(), std::move(fn), pool);
+            return;
+        }
+    }
+    out.Clear();
+    AppendParallel(out, in.GetSize(), [&in, &fn](auto& alloc, Out* place, size_t i) {
+        std::allocator_traits<std::decay_t<decltype(alloc)>>::construct(alloc, place, fn(in[i]));
+    }, pool);
+}
+
+// Параллельная копия вектора: замена конструктору копирования для больших векторов
+template <typename Type, typename... Params>
+SimpleVector<Type, Params...> Copy(const SimpleVector<Type, Params...>& v, ThreadPool& pool = DefaultThreadPool()) {
+    SimpleVector<Type, Params...> result(v.GetAllocator());
+    AppendParallel(result, v.GetSize(), [&v](auto& alloc, Type* place, size_t i) {
+        std::allocator_traits<std::decay_t<decltype(alloc)>>::construct(alloc, place, v[i]);
+    }, pool);
+    return result;
+}
+
+// Изменяет размер вектора; новые элементы — копии value, создаваемые параллельно.
+// Параллельная замена SimpleVector(size, value)
+template <typename Type, typename... Params>
+void Resize(SimpleVector<Type, Params...>& v, size_t new_size, const Type& value,
+            ThreadPool& pool = DefaultThreadPool()) {
+    if (new_size <= v.GetSize()) {
+        v.Resize(new_size);
+        return;
+    }
+    // value может быть элементом v, а AppendParallel переносит вектор в новую память
+    // до создания копий: такое значение сначала копируется
+    const std::less<const Type*> before;
+    if (!before(&value, v.GetData()) && before(&value, v.GetData() + v.GetSize())) {
+        const Type copy(value);
+        Resize(v, new_size, copy, pool);
+        return;
+    }
+    AppendParallel(v, new_size - v.GetSize(), [&value](auto& alloc, Type* place, size_t) {
+        std::allocator_traits<std::decay_t<decltype(alloc)>>::construct(alloc, place, value);
+    }, pool);
+}
+
+}  // namespace parallel
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Ленивый конвейер над диапазоном: Filter, Map, Take и Batch ничего не вычисляют и не создают
+// промежуточных векторов, а только описывают обработку. Работа идёт в терминальной операции
+// (ForEach, CollectInto) одним проходом: каждый элемент источника проходит все этапы сразу.
+//     SimpleVector<int> out;
+//     MakePipeline(v).Filter(is_even).Map(square).Take(100).CollectInto(out);
+// Этапы передают элементы следующему этапу вызовом sink(value). Если sink возвращает false,
+// дальше элементы не нужны (Take набрал своё) и обход источника прекращается.
+// Функции этапов копируются в конвейер; источник не копируется и должен жить, пока идёт обход
+namespace pipeline {
+
+// Что известно о числе элементов на выходе этапа до обхода
+enum class SizeKind {
+    EXACT,    // SizeHint() — точное число
+    AT_MOST,  // SizeHint() — верхняя граница (после Filter)
+    UNKNOWN,  // ничего не известно (источник без operator-)
+};
+
+template <typename Iterator, typename = void>
+struct HasDistance : std::false_type {};
+
+template <typename Iterator>
+struct HasDistance<Iterator, std::void_t<decltype(std::declval<Iterator>() - std::declval<Iterator>())>>
+: std::true_type {};
+
+// Источник: элементы [first, last)
+template <typename Iterator>
+class RangeStage {
+public:
+    using Reference = typename std::iterator_traits<Iterator>::reference;
+
+    static constexpr SizeKind SIZE_KIND = HasDistance<Iterator>::value ? SizeKind::EXACT : SizeKind::UNKNOWN;
+
+    RangeStage(Iterator first, Iterator last)
+    : first_(first), last_(last) {
+    }
+
+    size_t SizeHint() const {
+        if constexpr (HasDistance<Iterator>::value) {
+            return static_cast<size_t>(last_ - first_);
+        } else {
+            return 0;
+        }
+    }
+
+    // Возвращает false, если обход остановил sink
+    template <typename Sink>
+    bool Run(Sink& sink) const {
+        for (Iterator it = first_; it != last_; ++it) {
+            if (!sink(*it)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    Iterator first_;
+    Iterator last_;
+};
+
+// Пропускает дальше только элементы, для которых predicate(value) истинно
+template <typename Inner, typename Predicate>
+class FilterStage {
+public:
+    using Reference = typename Inner::Reference;
+
+    static constexpr SizeKind SIZE_KIND = Inner::SIZE_KIND == SizeKind::UNKNOWN ? SizeKind::UNKNOWN : SizeKind::AT_MOST;
+
+    FilterStage(Inner inner, Predicate predicate)
+    : inner_(std::move(inner)), predicate_(std::move(predicate)) {
+    }
+
+    size_t SizeHint() const {
+        return inner_.SizeHint();
+    }
+
+    template <typename Sink>
+    bool Run(Sink& sink) const {
+        auto filter = [&](Reference value) {
+            return !std::invoke(predicate_, std::as_const(value)) || sink(std::forward<Reference>(value));
+        };
+        return inner_.Run(filter);
+    }
+
+private:
+    Inner inner_;
+    Predicate predicate_;
+};
+
+// Передаёт дальше fn(value). Результат fn не сохраняется: временный объект живёт,
+// пока его обрабатывают следующие этапы
+template <typename Inner, typename Fn>
+class MapStage {
+public:
+    using Reference = std::invoke_result_t<const Fn&, typename Inner::Reference>;
+
+    static constexpr SizeKind SIZE_KIND = Inner::SIZE_KIND;
+
+    MapStage(Inner inner, Fn fn)
+    : inner_(std::move(inner)), fn_(std::move(fn)) {
+    }
+
+    size_t SizeHint() const {
+        return inner_.SizeHint();
+    }
+
+    template <typename Sink>
+    bool Run(Sink& sink) const {
+        auto map = [&](typename Inner::Reference value) {
+            return sink(std::invoke(fn_, std::forward<typename Inner::Reference>(value)));
+        };
+        return inner_.Run(map);
+    }
+
+private:
+    Inner inner_;
+    Fn fn_;
+};
+
+// Передаёт дальше не больше count первых элементов и останавливает обход источника,
+// как только они набраны
+template <typename Inner>
+class TakeStage {
+public:
+    using Reference = typename Inner::Reference;
+
+    static constexpr SizeKind SIZE_KIND = Inner::SIZE_KIND;
+
+    TakeStage(Inner inner, size_t count)
+    : inner_(std::move(inner)), count_(count) {
+    }
+
+    size_t SizeHint() const {
+        return std::min(count_, inner_.SizeHint());
+    }
+
+    template <typename Sink>
+    bool Run(Sink& sink) const {
+        if (count_ == 0) {
+            return true;
+        }
+        size_t left = count_;
+        bool open = true;
+        auto take = [&](Reference value) {
+            open = sink(std::forward<Reference>(value));
+            return open && --left != 0;
+        };
+        inner_.Run(take);
+        // Остановка из-за набранного count — нормальный конец потока, а не просьба sink
+        return open;
+    }
+
+private:
+    Inner inner_;
+    size_t count_;
+};
+
+// Собирает элементы в пачки по size штук и передаёт дальше const SimpleVector<Value>&,
+// последняя пачка может быть короче. Буфер пачки один на весь обход: память выделяется
+// один раз, а ссылка на пачку действительна только во время вызова следующего этапа
+template <typename Inner>
+class BatchStage {
+public:
+    using Value = std::remove_cv_t<std::remove_reference_t<typename Inner::Reference>>;
+    using Reference = const SimpleVector<Value>&;
+
+    static constexpr SizeKind SIZE_KIND = Inner::SIZE_KIND;
+
+    BatchStage(Inner inner, size_t size)
+    : inner_(std::move(inner)), size_(size) {
+        if (size == 0) {
+            throw std::invalid_argument("Batch size must be positive");
+        }
+    }
+
+    size_t SizeHint() const {
+        return (inner_.SizeHint() + size_ - 1) / size_;
+    }
+
+    template <typename Sink>
+    bool Run(Sink& sink) const {
+        SimpleVector<Value> batch(Reserve(size_));
+        bool open = true;
+        auto collect = [&](typename Inner::Reference value) {
+            batch.EmplaceBack(std::forward<typename Inner::Reference>(value));
+            if (batch.GetSize() < size_) {
+                return true;
+            }
+            open = sink(std::as_const(batch));
+            batch.Clear();
+            return open;
+        };
+        inner_.Run(collect);
+        return open && (batch.IsEmpty() || sink(std::as_const(batch)));
+    }
+
+private:
+    Inner inner_;
+    size_t size_;
+};
+
+}  // namespace pipeline
+
+// Конвейер с последним этапом Stage. Методы-этапы возвращают новый конвейер,
+// терминальные методы выполняют обход
+template <typename Stage>
+class Pipeline {
+public:
+    using Reference = typename Stage::Reference;
+    using ValueType = std::remove_cv_t<std::remove_reference_t<Reference>>;
+
+    explicit Pipeline(Stage stage)
+    : stage_(std::move(stage)) {
+    }
+
+    template <typename Predicate>
+    Pipeline<pipeline::FilterStage<Stage, Predicate>> Filter(Predicate predicate) const {
+        return Pipeline<pipeline::FilterStage<Stage, Predicate>>({stage_, std::move(predicate)});
+    }
+
+    template <typename Fn>
+    Pipeline<pipeline::MapStage<Stage, Fn>> Map(Fn fn) const {
+        return Pipeline<pipeline::MapStage<Stage, Fn>>({stage_, std::move(fn)});
+    }
+
+    Pipeline<pipeline::TakeStage<Stage>> Take(size_t count) const {
+        return Pipeline<pipeline::TakeStage<Stage>>({stage_, count});
+    }
+
+    // Пачки по size элементов (см. pipeline::BatchStage). При size == 0 бросает std::invalid_argument
+    Pipeline<pipeline::BatchStage<Stage>> Batch(size_t size) const {
+        return Pipeline<pipeline::BatchStage<Stage>>({stage_, size});
+    }
+
+    // Верхняя граница или точное число элементов на выходе, см. GetSizeKind()
+    size_t SizeHint() const {
+        return stage_.SizeHint();
+    }
+
+    static constexpr pipeline::SizeKind GetSizeKind() noexcept {
+        return Stage::SIZE_KIND;
+    }
+
+    // Вызывает fn для каждого элемента
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+        auto sink = [&fn](Reference value) {
+            std::invoke(fn, std::forward<Reference>(value));
+            return true;
+        };
+        stage_.Run(sink);
+    }
+
+    // Добавляет элементы в конец out. Память резервируется заранее:
+    //  - число элементов известно точно (нет Filter) — ровно под них, одно выделение;
+    //  - известна верхняя граница (после Filter) — под границу; если в итоге занято меньше
+    //    половины выделенного, лишняя память отдаётся через ShrinkToFit. Нетронутые страницы
+    //    большого блока не стоят физической памяти, а рост вдвое переносил бы элементы log(n) раз;
+    //  - ничего не известно — растёт по политике роста out.
+    // Если элемент бросает исключение, уже добавленные элементы остаются в out
+    template <typename Type, typename Allocator, typename GrowthPolicy, typename Instrumentation>
+    void CollectInto(SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& out) const {
+        const size_t old_capacity = out.GetCapacity();
+        if constexpr (Stage::SIZE_KIND != pipeline::SizeKind::UNKNOWN) {
+            out.Reserve(out.GetSize() + stage_.SizeHint());
+        }
+        auto sink = [&out](Reference value) {
+            out.EmplaceBack(std::forward<Reference>(value));
+            return true;
+        };
+        stage_.Run(sink);
+        if constexpr (Stage::SIZE_KIND == pipeline::SizeKind::AT_MOST) {
+            if (out.GetCapacity() > old_capacity && out.GetSize() < out.GetCapacity() / 2) {
+                out.ShrinkToFit();
+            }
+        }
+    }
+
+private:
+    Stage stage_;
+};
+
+// Конвейер над [first, last)
+template <typename Iterator>
+Pipeline<pipeline::RangeStage<Iterator>> MakePipeline(Iterator first, Iterator last) {
+    return Pipeline<pipeline::RangeStage<Iterator>>({first, last});
+}
+
+// Конвейер над элементами range: SimpleVector, любой контейнер или Prefetched(...).
+// Конвейер хранит итераторы range, а не его копию
+template <typename Range>
+auto MakePipeline(Range&& range) {
+    using std::begin;
+    using std::end;
+    return MakePipeline(begin(range), end(range));
+}
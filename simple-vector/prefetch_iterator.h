@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+// Число элементов, на которое PrefetchIterator по умолчанию заглядывает вперёд.
+// Должно покрывать задержку памяти: примерно задержка промаха / время обработки элемента
+inline constexpr size_t DEFAULT_PREFETCH_DISTANCE = 16;
+
+// Подсказка процессору загрузить в кэш строку с адресом address для чтения.
+// Не обращается к памяти и не может упасть, даже если адрес недействителен
+inline void PrefetchRead(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    static_cast<void>(address);
+#endif
+}
+
+// Проекция по умолчанию: что загружать для элемента. Для указателя — объект, на который он
+// указывает (обход вектора указателей на разбросанные по памяти объекты), иначе — сам элемент
+struct PrefetchTarget {
+    template <typename T>
+    const void* operator()(const T& element) const noexcept {
+        if constexpr (std::is_pointer_v<T>) {
+            return element;
+        } else {
+            return std::addressof(element);
+        }
+    }
+};
+
+// Однонаправленный итератор поверх итератора с произвольным доступом: при каждом шаге
+// просит процессор загрузить данные элемента, стоящего на distance позиций впереди.
+// Какие данные загружать, решает projection(element) -> const void*: например,
+// [&table](int id) { return &table[id]; } для вектора номеров строк большой таблицы.
+// Итератор помнит конец диапазона и не заглядывает за него.
+// Аппаратная предвыборка сама справляется с последовательным обходом, поэтому адаптер полезен,
+// когда элементы указывают в другую большую структуру и следующий адрес непредсказуем
+template <typename Iterator, typename Projection = PrefetchTarget>
+class PrefetchIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+    using pointer = typename std::iterator_traits<Iterator>::pointer;
+    using reference = typename std::iterator_traits<Iterator>::reference;
+
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<Iterator>::iterator_category>,
+                  "PrefetchIterator needs a random access iterator");
+
+    PrefetchIterator() = default;
+
+    // Итератор на current в диапазоне [current, last). Сразу запрашивает первые distance элементов
+    PrefetchIterator(Iterator current, Iterator last, size_t distance, Projection projection = Projection())
+    : current_(current), ahead_(current), last_(last), projection_(std::move(projection)) {
+        const difference_type warmup = std::min<difference_type>(static_cast<difference_type>(distance), last - current);
+        for (difference_type i = 0; i < warmup; ++i, ++ahead_) {
+            PrefetchRead(projection_(*ahead_));
+        }
+    }
+
+    Iterator Base() const {
+        return current_;
+    }
+
+    reference operator*() const {
+        return *current_;
+    }
+
+    pointer operator->() const {
+        return std::addressof(*current_);
+    }
+
+    PrefetchIterator& operator++() {
+        ++current_;
+        if (ahead_ != last_) {
+            PrefetchRead(projection_(*ahead_));
+            ++ahead_;
+        }
+        return *this;
+    }
+
+    PrefetchIterator operator++(int) {
+        PrefetchIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    // Число элементов между итераторами, как у исходного итератора: позволяет заранее
+    // узнать длину диапазона (см. Pipeline::CollectInto)
+    friend difference_type operator-(const PrefetchIterator& lhs, const PrefetchIterator& rhs) {
+        return lhs.current_ - rhs.current_;
+    }
+
+    friend bool operator==(const PrefetchIterator& lhs, const PrefetchIterator& rhs) {
+        return lhs.current_ == rhs.current_;
+    }
+
+    friend bool operator!=(const PrefetchIterator& lhs, const PrefetchIterator& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    Iterator current_{};
+    // Следующий элемент, который нужно запросить: current_ + distance, но не дальше last_
+    Iterator ahead_{};
+    Iterator last_{};
+    Projection projection_{};
+};
+
+// Диапазон [begin, end) из PrefetchIterator, пригодный для range-based for и MakePipeline
+template <typename Iterator, typename Projection = PrefetchTarget>
+class PrefetchRange {
+public:
+    using iterator = PrefetchIterator<Iterator, Projection>;
+
+    PrefetchRange(Iterator first, Iterator last, size_t distance, Projection projection = Projection())
+    : first_(first, last, distance, projection), last_(last, last, 0, std::move(projection)) {
+    }
+
+    iterator begin() const {
+        return first_;
+    }
+
+    iterator end() const {
+        return last_;
+    }
+
+private:
+    iterator first_;
+    iterator last_;
+};
+
+// Обход container с предвыборкой на distance элементов вперёд:
+//     for (const Node* node : Prefetched(nodes, 8)) { sum += node->value; }
+// Контейнер не должен меняться, пока идёт обход
+template <typename Container, typename Projection = PrefetchTarget>
+auto Prefetched(Container& container, size_t distance = DEFAULT_PREFETCH_DISTANCE,
+                Projection projection = Projection()) {
+    using std::begin;
+    using std::end;
+    return PrefetchRange<decltype(begin(container)), Projection>(begin(container), end(container), distance,
+                                                                 std::move(projection));
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "index_iterator.h"
+#include "simple_vector.h"
+
+// Число элементов в куске SegmentedVector по умолчанию: степень двойки, кусок около 16 КиБ
+template <typename Type>
+constexpr size_t DefaultSegmentSize() noexcept {
+    size_t size = 8;
+    while (size * 2 * sizeof(Type) <= 16 * 1024) {
+        size *= 2;
+    }
+    return size;
+}
+
+// Вектор из кусков по SegmentSize элементов и индекса указателей на куски.
+// При росте выделяется новый кусок, а существующие элементы никогда не переносятся:
+// PushBack стоит O(1) без всплесков задержки на копирование, ссылки на элементы
+// остаются действительными. При росте переносится только индекс — SimpleVector указателей,
+// в SegmentSize раз меньший самих данных. Доступ по индексу — O(1): сдвиг и маска.
+// Итераторы хранят вектор и номер элемента, поэтому PushBack их тоже не портит
+template <typename Type, size_t SegmentSize = DefaultSegmentSize<Type>(), typename Allocator = std::allocator<Type>>
+class SegmentedVector {
+    static_assert(SegmentSize > 0 && (SegmentSize & (SegmentSize - 1)) == 0, "SegmentSize must be a power of two");
+
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    using IndexAllocator = typename AllocatorTraits::template rebind_alloc<Type*>;
+
+public:
+    using Iterator = IndexIterator<SegmentedVector, Type>;
+    using ConstIterator = IndexIterator<SegmentedVector, const Type>;
+    using AllocatorType = Allocator;
+
+    static constexpr size_t SEGMENT_SIZE = SegmentSize;
+
+    SegmentedVector() noexcept = default;
+
+    explicit SegmentedVector(const Allocator& alloc) noexcept
+    : segments_(IndexAllocator(alloc)), alloc_(alloc) {
+    }
+
+    explicit SegmentedVector(size_t size, const Allocator& alloc = Allocator())
+    : SegmentedVector(alloc) {
+        Resize(size);
+    }
+
+    SegmentedVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+    : SegmentedVector(alloc) {
+        Reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(value);
+        }
+    }
+
+    SegmentedVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+    : SegmentedVector(alloc) {
+        Reserve(init.size());
+        for (const Type& value : init) {
+            PushBack(value);
+        }
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+    : SegmentedVector(AllocatorTraits::select_on_container_copy_construction(other.alloc_)) {
+        Reserve(other.size_);
+        for (const Type& value : other) {
+            PushBack(value);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+    : segments_(std::move(other.segments_)), size_(std::exchange(other.size_, 0)), alloc_(other.alloc_) {
+    }
+
+    ~SegmentedVector() {
+        Clear();
+        for (Type* segment : segments_) {
+            AllocatorTraits::deallocate(alloc_, segment, SegmentSize);
+        }
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector copy(rhs);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            SegmentedVector moved(std::move(rhs));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    Allocator GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Вместимость выделенных кусков
+    size_t GetCapacity() const noexcept {
+        return segments_.GetSize() * SegmentSize;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    Type& operator[](size_t index) noexcept {
+        return segments_[index / SegmentSize][index % SegmentSize];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return segments_[index / SegmentSize][index % SegmentSize];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    // Разрушает элементы, куски остаются выделенными
+    void Clear() noexcept {
+        while (size_ != 0) {
+            PopBack();
+        }
+    }
+
+    // Выделяет куски под new_capacity элементов
+    void Reserve(size_t new_capacity) {
+        const size_t segment_count = (new_capacity + SegmentSize - 1) / SegmentSize;
+        if (segment_count <= segments_.GetSize()) {
+            return;
+        }
+        segments_.Reserve(segment_count);
+        while (segments_.GetSize() < segment_count) {
+            AddSegment();
+        }
+    }
+
+    // Новые элементы создаются значением по умолчанию. Если конструктор бросит исключение,
+    // созданные элементы разрушаются и размер не меняется
+    void Resize(size_t new_size) {
+        const size_t old_size = size_;
+        Reserve(new_size);
+        try {
+            while (size_ < new_size) {
+                EmplaceBack();
+            }
+        } catch (...) {
+            while (size_ > old_size) {
+                PopBack();
+            }
+            throw;
+        }
+        while (size_ > new_size) {
+            PopBack();
+        }
+    }
+
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце. Существующие элементы не переносятся никогда
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            AddSegment();
+        }
+        Type* place = &(*this)[size_];
+        AllocatorTraits::construct(alloc_, place, std::forward<Args>(args)...);
+        ++size_;
+        return *place;
+    }
+
+    // Для пустого вектора ничего не делает, как SimpleVector::PopBack
+    void PopBack() noexcept {
+        if (size_ == 0) {
+            return;
+        }
+        --size_;
+        AllocatorTraits::destroy(alloc_, &(*this)[size_]);
+    }
+
+    // Вставка и удаление сдвигают хвост поэлементно за O(n), как у SimpleVector
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = pos - cbegin();
+        if (index == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+        } else {
+            // Аргументы могут ссылаться на элементы вектора: сначала создаём значение
+            Type value(std::forward<Args>(args)...);
+            EmplaceBack(std::move((*this)[size_ - 1]));
+            std::move_backward(begin() + index, end() - 2, end() - 1);
+            (*this)[index] = std::move(value);
+        }
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t from = first - cbegin();
+        const size_t to = last - cbegin();
+        std::move(begin() + to, end(), begin() + from);
+        for (size_t i = to; i > from; --i) {
+            PopBack();
+        }
+        return begin() + from;
+    }
+
+    void swap(SegmentedVector& other) noexcept {
+        segments_.swap(other.segments_);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, size_);
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, size_);
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    friend bool operator==(const SegmentedVector& lhs, const SegmentedVector& rhs) {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const SegmentedVector& lhs, const SegmentedVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const SegmentedVector& lhs, const SegmentedVector& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator>(const SegmentedVector& lhs, const SegmentedVector& rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator<=(const SegmentedVector& lhs, const SegmentedVector& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>=(const SegmentedVector& lhs, const SegmentedVector& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    // Выделяет ещё один кусок. Если индекс не удалось расширить, кусок освобождается
+    void AddSegment() {
+        Type* segment = AllocatorTraits::allocate(alloc_, SegmentSize);
+        try {
+            segments_.PushBack(segment);
+        } catch (...) {
+            AllocatorTraits::deallocate(alloc_, segment, SegmentSize);
+            throw;
+        }
+    }
+
+    SimpleVector<Type*, IndexAllocator> segments_;
+    size_t size_ = 0;
+    Allocator alloc_;
+};
@@ -0,0 +1,555 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "checked_iterator.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMPLE_VECTOR_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Векторизованные алгоритмы для массивов int32_t, float, double и uint8_t:
+// Equal, Compare, Find, Count, Fill, Sum, MinMax.
+// Набор инструкций (AVX2, SSE2 или скалярный код) выбирается во время выполнения
+// по возможностям процессора. Для других типов элементов функции работают скалярно.
+// Sum накапливает int32_t в int64_t, uint8_t в uint64_t, float в double.
+// Для float/double с NaN результат MinMax не определён, а порядок суммирования
+// отличается от последовательного, поэтому сумма может отличаться в последних битах
+namespace simd {
+
+template <typename T>
+inline constexpr bool IsSimdElementV = std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint8_t>
+    || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// Тип результата Sum для элементов T
+template <typename T>
+using SumTypeOf = std::conditional_t<std::is_floating_point_v<T>, double,
+                                     std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+// Лучший набор инструкций, поддерживаемый процессором
+inline SimdLevel DetectSimdLevel() noexcept {
+#ifdef SIMPLE_VECTOR_X86_SIMD
+    static const SimdLevel level = __builtin_cpu_supports("avx2") ? SimdLevel::AVX2
+        : __builtin_cpu_supports("sse2")                         ? SimdLevel::SSE2
+                                                                  : SimdLevel::SCALAR;
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+inline SimdLevel& ActiveLevelStorage() noexcept {
+    static SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+// Набор инструкций, которым сейчас пользуются алгоритмы
+inline SimdLevel GetSimdLevel() noexcept {
+    return ActiveLevelStorage();
+}
+
+// Ограничивает набор инструкций уровнем level (например, для сравнения в бенчмарках).
+// Уровень выше поддерживаемого процессором понижается до поддерживаемого
+inline void SetSimdLevel(SimdLevel level) noexcept {
+    ActiveLevelStorage() = std::min(level, DetectSimdLevel());
+}
+
+namespace scalar {
+
+template <typename T>
+size_t Mismatch(const T* a, const T* b, size_t n) {
+    return static_cast<size_t>(std::mismatch(a, a + n, b).first - a);
+}
+
+template <typename T>
+size_t Find(const T* data, size_t n, T value) {
+    return static_cast<size_t>(std::find(data, data + n, value) - data);
+}
+
+template <typename T>
+size_t Count(const T* data, size_t n, T value) {
+    return static_cast<size_t>(std::count(data, data + n, value));
+}
+
+template <typename T>
+void Fill(T* data, size_t n, T value) {
+    std::fill(data, data + n, value);
+}
+
+template <typename T>
+SumTypeOf<T> Sum(const T* data, size_t n) {
+    SumTypeOf<T> sum{};
+    for (size_t i = 0; i < n; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+template <typename T>
+std::pair<T, T> MinMax(const T* data, size_t n) {
+    SIMPLE_VECTOR_CHECK(n != 0, "MinMax of an empty range");
+    T min = data[0];
+    T max = data[0];
+    for (size_t i = 1; i < n; ++i) {
+        min = data[i] < min ? data[i] : min;
+        max = max < data[i] ? data[i] : max;
+    }
+    return {min, max};
+}
+
+}  // namespace scalar
+
+#ifdef SIMPLE_VECTOR_X86_SIMD
+
+namespace sse2 {
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<std::int32_t> {
+    using Reg = __m128i;
+    using Acc = __m128i;  // два int64
+    using SumType = std::int64_t;
+    static constexpr size_t WIDTH = 4;
+
+    static Reg Load(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void Store(std::int32_t* p, Reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static Reg Set1(std::int32_t value) { return _mm_set1_epi32(value); }
+    static unsigned EqMask(Reg a, Reg b) {
+        return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))));
+    }
+    // В SSE2 нет min/max для int32, выбираем через маску сравнения
+    static Reg Min(Reg a, Reg b) {
+        const Reg greater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(greater, b), _mm_andnot_si128(greater, a));
+    }
+    static Reg Max(Reg a, Reg b) {
+        const Reg greater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+    }
+    static Acc AccZero() { return _mm_setzero_si128(); }
+    static Acc Accumulate(Acc acc, Reg v) {
+        const Reg sign = _mm_srai_epi32(v, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+        return _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+    }
+    static SumType Reduce(Acc acc) {
+        alignas(16) std::int64_t lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        return lanes[0] + lanes[1];
+    }
+    static std::int32_t HorizontalMin(Reg v) {
+        alignas(16) std::int32_t lanes[WIDTH];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+        return *std::min_element(lanes, lanes + WIDTH);
+    }
+    static std::int32_t HorizontalMax(Reg v) {
+        alignas(16) std::int32_t lanes[WIDTH];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+        return *std::max_element(lanes, lanes + WIDTH);
+    }
+};
+
+template <>
+struct Ops<std::uint8_t> {
+    using Reg = __m128i;
+    using Acc = __m128i;  // два uint64
+    using SumType = std::uint64_t;
+    static constexpr size_t WIDTH = 16;
+
+    static Reg Load(const std::uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void Store(std::uint8_t* p, Reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static Reg Set1(std::uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+    static unsigned EqMask(Reg a, Reg b) { return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))); }
+    static Reg Min(Reg a, Reg b) { return _mm_min_epu8(a, b); }
+    static Reg Max(Reg a, Reg b) { return _mm_max_epu8(a, b); }
+    static Acc AccZero() { return _mm_setzero_si128(); }
+    static Acc Accumulate(Acc acc, Reg v) { return _mm_add_epi64(acc, _mm_sad_epu8(v, _mm_setzero_si128())); }
+    static SumType Reduce(Acc acc) {
+        alignas(16) std::uint64_t lanes[2];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        return lanes[0] + lanes[1];
+    }
+    static std::uint8_t HorizontalMin(Reg v) {
+        alignas(16) std::uint8_t lanes[WIDTH];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+        return *std::min_element(lanes, lanes + WIDTH);
+    }
+    static std::uint8_t HorizontalMax(Reg v) {
+        alignas(16) std::uint8_t lanes[WIDTH];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+        return *std::max_element(lanes, lanes + WIDTH);
+    }
+};
+
+template <>
+struct Ops<float> {
+    using Reg = __m128;
+    using Acc = __m128d;
+    using SumType = double;
+    static constexpr size_t WIDTH = 4;
+
+    static Reg Load(const float* p) { return _mm_loadu_ps(p); }
+    static void Store(float* p, Reg v) { _mm_storeu_ps(p, v); }
+    static Reg Set1(float value) { return _mm_set1_ps(value); }
+    static unsigned EqMask(Reg a, Reg b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+    static Reg Min(Reg a, Reg b) { return _mm_min_ps(a, b); }
+    static Reg Max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+    static Acc AccZero() { return _mm_setzero_pd(); }
+    static Acc Accumulate(Acc acc, Reg v) {
+        acc = _mm_add_pd(acc, _mm_cvtps_pd(v));
+        return _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    }
+    static SumType Reduce(Acc acc) {
+        alignas(16) double lanes[2];
+        _mm_store_pd(lanes, acc);
+        return lanes[0] + lanes[1];
+    }
+    static float HorizontalMin(Reg v) {
+        alignas(16) float lanes[WIDTH];
+        _mm_store_ps(lanes, v);
+        return *std::min_element(lanes, lanes + WIDTH);
+    }
+    static float HorizontalMax(Reg v) {
+        alignas(16) float lanes[WIDTH];
+        _mm_store_ps(lanes, v);
+        return *std::max_element(lanes, lanes + WIDTH);
+    }
+};
+
+template <>
+struct Ops<double> {
+    using Reg = __m128d;
+    using Acc = __m128d;
+    using SumType = double;
+    static constexpr size_t WIDTH = 2;
+
+    static Reg Load(const double* p) { return _mm_loadu_pd(p); }
+    static void Store(double* p, Reg v) { _mm_storeu_pd(p, v); }
+    static Reg Set1(double value) { return _mm_set1_pd(value); }
+    static unsigned EqMask(Reg a, Reg b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+    static Reg Min(Reg a, Reg b) { return _mm_min_pd(a, b); }
+    static Reg Max(Reg a, Reg b) { return _mm_max_pd(a, b); }
+    static Acc AccZero() { return _mm_setzero_pd(); }
+    static Acc Accumulate(Acc acc, Reg v) { return _mm_add_pd(acc, v); }
+    static SumType Reduce(Acc acc) {
+        alignas(16) double lanes[2];
+        _mm_store_pd(lanes, acc);
+        return lanes[0] + lanes[1];
+    }
+    static double HorizontalMin(Reg v) {
+        alignas(16) double lanes[WIDTH];
+        _mm_store_pd(lanes, v);
+        return std::min(lanes[0], lanes[1]);
+    }
+    static double HorizontalMax(Reg v) {
+        alignas(16) double lanes[WIDTH];
+        _mm_store_pd(lanes, v);
+        return std::max(lanes[0], lanes[1]);
+    }
+};
+
+#include "simd_kernels.h"
+
+}  // namespace sse2
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+template <typename T>
+struct Ops;
+
+template <>
+struct Ops<std::int32_t> {
+    using Reg = __m256i;
+    using Acc = __m256i;  // четыре int64
+    using SumType = std::int64_t;
+    static constexpr size_t WIDTH = 8;
+
+    static Reg Load(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void Store(std::int32_t* p, Reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Reg Set1(std::int32_t value) { return _mm256_set1_epi32(value); }
+    static unsigned EqMask(Reg a, Reg b) {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+    }
+    static Reg Min(Reg a, Reg b) { return _mm256_min_epi32(a, b); }
+    static Reg Max(Reg a, Reg b) { return _mm256_max_epi32(a, b); }
+    static Acc AccZero() { return _mm256_setzero_si256(); }
+    static Acc Accumulate(Acc acc, Reg v) {
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    static SumType Reduce(Acc acc) {
+        alignas(32) std::int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    static std::int32_t HorizontalMin(Reg v) {
+        alignas(32) std::int32_t lanes[WIDTH];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+        return *std::min_element(lanes, lanes + WIDTH);
+    }
+    static std::int32_t HorizontalMax(Reg v) {
+        alignas(32) std::int32_t lanes[WIDTH];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+        return *std::max_element(lanes, lanes + WIDTH);
+    }
+};
+
+template <>
+struct Ops<std::uint8_t> {
+    using Reg = __m256i;
+    using Acc = __m256i;  // четыре uint64
+    using SumType = std::uint64_t;
+    static constexpr size_t WIDTH = 32;
+
+    static Reg Load(const std::uint8_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void Store(std::uint8_t* p, Reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Reg Set1(std::uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+    static unsigned EqMask(Reg a, Reg b) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+    }
+    static Reg Min(Reg a, Reg b) { return _mm256_min_epu8(a, b); }
+    static Reg Max(Reg a, Reg b) { return _mm256_max_epu8(a, b); }
+    static Acc AccZero() { return _mm256_setzero_si256(); }
+    static Acc Accumulate(Acc acc, Reg v) { return _mm256_add_epi64(acc, _mm256_sad_epu8(v, _mm256_setzero_si256())); }
+    static SumType Reduce(Acc acc) {
+        alignas(32) std::uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    static std::uint8_t HorizontalMin(Reg v) {
+        alignas(32) std::uint8_t lanes[WIDTH];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+        return *std::min_element(lanes, lanes + WIDTH);
+    }
+    static std::uint8_t HorizontalMax(Reg v) {
+        alignas(32) std::uint8_t lanes[WIDTH];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+        return *std::max_element(lanes, lanes + WIDTH);
+    }
+};
+
+template <>
+struct Ops<float> {
+    using Reg = __m256;
+    using Acc = __m256d;
+    using SumType = double;
+    static constexpr size_t WIDTH = 8;
+
+    static Reg Load(const float* p) { return _mm256_loadu_ps(p); }
+    static void Store(float* p, Reg v) { _mm256_storeu_ps(p, v); }
+    static Reg Set1(float value) { return _mm256_set1_ps(value); }
+    static unsigned EqMask(Reg a, Reg b) {
+        return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+    }
+    static Reg Min(Reg a, Reg b) { return _mm256_min_ps(a, b); }
+    static Reg Max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+    static Acc AccZero() { return _mm256_setzero_pd(); }
+    static Acc Accumulate(Acc acc, Reg v) {
+        acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        return _mm256_add_pd(acc, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+    static SumType Reduce(Acc acc) {
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, acc);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    static float HorizontalMin(Reg v) {
+        alignas(32) float lanes[WIDTH];
+        _mm256_store_ps(lanes, v);
+        return *std::min_element(lanes, lanes + WIDTH);
+    }
+    static float HorizontalMax(Reg v) {
+        alignas(32) float lanes[WIDTH];
+        _mm256_store_ps(lanes, v);
+        return *std::max_element(lanes, lanes + WIDTH);
+    }
+};
+
+template <>
+struct Ops<double> {
+    using Reg = __m256d;
+    using Acc = __m256d;
+    using SumType = double;
+    static constexpr size_t WIDTH = 4;
+
+    static Reg Load(const double* p) { return _mm256_loadu_pd(p); }
+    static void Store(double* p, Reg v) { _mm256_storeu_pd(p, v); }
+    static Reg Set1(double value) { return _mm256_set1_pd(value); }
+    static unsigned EqMask(Reg a, Reg b) {
+        return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+    }
+    static Reg Min(Reg a, Reg b) { return _mm256_min_pd(a, b); }
+    static Reg Max(Reg a, Reg b) { return _mm256_max_pd(a, b); }
+    static Acc AccZero() { return _mm256_setzero_pd(); }
+    static Acc Accumulate(Acc acc, Reg v) { return _mm256_add_pd(acc, v); }
+    static SumType Reduce(Acc acc) {
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, acc);
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    static double HorizontalMin(Reg v) {
+        alignas(32) double lanes[WIDTH];
+        _mm256_store_pd(lanes, v);
+        return *std::min_element(lanes, lanes + WIDTH);
+    }
+    static double HorizontalMax(Reg v) {
+        alignas(32) double lanes[WIDTH];
+        _mm256_store_pd(lanes, v);
+        return *std::max_element(lanes, lanes + WIDTH);
+    }
+};
+
+#include "simd_kernels.h"
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#endif  // SIMPLE_VECTOR_X86_SIMD
+
+// Вызывает ядро Kernel из пространства имён текущего набора инструкций
+#ifdef SIMPLE_VECTOR_X86_SIMD
+#define SIMPLE_VECTOR_SIMD_DISPATCH(T, Kernel, ...)              \
+    do {                                                         \
+        if constexpr (IsSimdElementV<T>) {                       \
+            switch (GetSimdLevel()) {                            \
+            case SimdLevel::AVX2:                                \
+                return avx2::Kernel(__VA_ARGS__);                \
+            case SimdLevel::SSE2:                                \
+                return sse2::Kernel(__VA_ARGS__);                \
+            case SimdLevel::SCALAR:                              \
+                break;                                           \
+            }                                                    \
+        }                                                        \
+        return scalar::Kernel(__VA_ARGS__);                      \
+    } while (false)
+#else
+#define SIMPLE_VECTOR_SIMD_DISPATCH(T, Kernel, ...) return scalar::Kernel(__VA_ARGS__)
+#endif
+
+// Индекс первой позиции, где a и b различаются, или n
+template <typename T>
+size_t Mismatch(const T* a, const T* b, size_t n) {
+    SIMPLE_VECTOR_SIMD_DISPATCH(T, Mismatch, a, b, n);
+}
+
+// Сравнивает массивы a и b длины n поэлементно оператором ==
+template <typename T>
+bool Equal(const T* a, const T* b, size_t n) {
+    return Mismatch(a, b, n) == n;
+}
+
+// Лексикографически сравнивает a[0, n) и b[0, m) так же, как std::lexicographical_compare.
+// Возвращает отрицательное число, если a < b, положительное, если b < a, и 0 иначе
+template <typename T>
+int Compare(const T* a, size_t n, const T* b, size_t m) {
+    const size_t common = std::min(n, m);
+    size_t i = 0;
+    while (i < common) {
+        i += Mismatch(a + i, b + i, common - i);
+        if (i == common) {
+            break;
+        }
+        if (a[i] < b[i]) {
+            return -1;
+        }
+        if (b[i] < a[i]) {
+            return 1;
+        }
+        // Несравнимые значения (NaN) считаются эквивалентными, продолжаем
+        ++i;
+    }
+    return n < m ? -1 : (m < n ? 1 : 0);
+}
+
+// Индекс первого элемента, равного value, или n
+template <typename T>
+size_t Find(const T* data, size_t n, T value) {
+    SIMPLE_VECTOR_SIMD_DISPATCH(T, Find, data, n, value);
+}
+
+template <typename T>
+size_t Count(const T* data, size_t n, T value) {
+    SIMPLE_VECTOR_SIMD_DISPATCH(T, Count, data, n, value);
+}
+
+template <typename T>
+void Fill(T* data, size_t n, T value) {
+    SIMPLE_VECTOR_SIMD_DISPATCH(T, Fill, data, n, value);
+}
+
+template <typename T>
+SumTypeOf<T> Sum(const T* data, size_t n) {
+    SIMPLE_VECTOR_SIMD_DISPATCH(T, Sum, data, n);
+}
+
+// Минимум и максимум массива. Для пустого массива выбрасывает std::invalid_argument
+template <typename T>
+std::pair<T, T> MinMax(const T* data, size_t n) {
+    if (n == 0) {
+        throw std::invalid_argument("MinMax of an empty range");
+    }
+    SIMPLE_VECTOR_SIMD_DISPATCH(T, MinMax, data, n);
+}
+
+#undef SIMPLE_VECTOR_SIMD_DISPATCH
+
+// Варианты для векторов с непрерывной памятью (SimpleVector, SmallSimpleVector и т.п.).
+// Итераторы отладочного режима SimpleVector разворачиваются в указатели (см. checked_iterator.h)
+
+template <typename Vector>
+bool Equal(const Vector& lhs, const Vector& rhs) {
+    return lhs.GetSize() == rhs.GetSize()
+        && Equal(UnwrapIterator(lhs.begin()), UnwrapIterator(rhs.begin()), lhs.GetSize());
+}
+
+template <typename Vector>
+int Compare(const Vector& lhs, const Vector& rhs) {
+    return Compare(UnwrapIterator(lhs.begin()), lhs.GetSize(), UnwrapIterator(rhs.begin()), rhs.GetSize());
+}
+
+// Индекс первого элемента, равного value, или размер вектора
+template <typename Vector, typename T>
+size_t Find(const Vector& v, const T& value) {
+    return Find(UnwrapIterator(v.begin()), v.GetSize(), static_cast<std::decay_t<decltype(*v.begin())>>(value));
+}
+
+template <typename Vector, typename T>
+size_t Count(const Vector& v, const T& value) {
+    return Count(UnwrapIterator(v.begin()), v.GetSize(), static_cast<std::decay_t<decltype(*v.begin())>>(value));
+}
+
+template <typename Vector, typename T>
+void Fill(Vector& v, const T& value) {
+    Fill(UnwrapIterator(v.begin()), v.GetSize(), static_cast<std::decay_t<decltype(*v.begin())>>(value));
+}
+
+template <typename Vector>
+auto Sum(const Vector& v) {
+    return Sum(UnwrapIterator(v.begin()), v.GetSize());
+}
+
+// Минимум и максимум вектора. Для пустого вектора выбрасывает std::invalid_argument
+template <typename Vector>
+auto MinMax(const Vector& v) {
+    return MinMax(UnwrapIterator(v.begin()), v.GetSize());
+}
+
+}  // namespace simd
@@ -0,0 +1,124 @@
+// Обобщённые ядра поиска, сравнения и свёртки поверх Ops<T> одного набора инструкций.
+// Файл без #pragma once: simd_algorithms.h включает его внутри каждого пространства имён
+// simd::sse2 и simd::avx2, чтобы ядра компилировались под целевые инструкции этого
+// пространства и встраивали его Ops<T>. Ops<T> предоставляет:
+//     Reg, WIDTH, Load, Store, Set1, EqMask (бит на каждую совпавшую позицию), Min, Max;
+//     Acc, SumType, AccZero, Accumulate, Reduce — для суммирования;
+//     HorizontalMin/HorizontalMax — свёртку регистра в одно значение.
+
+// Число единичных бит. Без -mpopcnt __builtin_popcount превращается в вызов функции
+inline unsigned PopCount(unsigned mask) {
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    return (((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+// Индекс первой позиции, где a и b различаются, или n
+template <typename T>
+size_t Mismatch(const T* a, const T* b, size_t n) {
+    using O = Ops<T>;
+    constexpr unsigned full_mask = (O::WIDTH == 32) ? ~0u : ((1u << O::WIDTH) - 1);
+    size_t i = 0;
+    for (; i + O::WIDTH <= n; i += O::WIDTH) {
+        const unsigned equal = O::EqMask(O::Load(a + i), O::Load(b + i));
+        if (equal != full_mask) {
+            return i + static_cast<size_t>(__builtin_ctz(~equal));
+        }
+    }
+    for (; i < n; ++i) {
+        if (!(a[i] == b[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Индекс первого элемента, равного value, или n
+template <typename T>
+size_t Find(const T* data, size_t n, T value) {
+    using O = Ops<T>;
+    const typename O::Reg needle = O::Set1(value);
+    size_t i = 0;
+    for (; i + O::WIDTH <= n; i += O::WIDTH) {
+        const unsigned equal = O::EqMask(O::Load(data + i), needle);
+        if (equal != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(equal));
+        }
+    }
+    for (; i < n; ++i) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Количество элементов, равных value
+template <typename T>
+size_t Count(const T* data, size_t n, T value) {
+    using O = Ops<T>;
+    const typename O::Reg needle = O::Set1(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + O::WIDTH <= n; i += O::WIDTH) {
+        count += PopCount(O::EqMask(O::Load(data + i), needle));
+    }
+    for (; i < n; ++i) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+template <typename T>
+void Fill(T* data, size_t n, T value) {
+    using O = Ops<T>;
+    const typename O::Reg filler = O::Set1(value);
+    size_t i = 0;
+    for (; i + O::WIDTH <= n; i += O::WIDTH) {
+        O::Store(data + i, filler);
+    }
+    for (; i < n; ++i) {
+        data[i] = value;
+    }
+}
+
+template <typename T>
+typename Ops<T>::SumType Sum(const T* data, size_t n) {
+    using O = Ops<T>;
+    typename O::Acc acc = O::AccZero();
+    size_t i = 0;
+    for (; i + O::WIDTH <= n; i += O::WIDTH) {
+        acc = O::Accumulate(acc, O::Load(data + i));
+    }
+    typename O::SumType sum = O::Reduce(acc);
+    for (; i < n; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+// Минимум и максимум непустого диапазона
+template <typename T>
+std::pair<T, T> MinMax(const T* data, size_t n) {
+    SIMPLE_VECTOR_CHECK(n != 0, "MinMax of an empty range");
+    using O = Ops<T>;
+    T min = data[0];
+    T max = data[0];
+    size_t i = 0;
+    if (n >= O::WIDTH) {
+        typename O::Reg min_reg = O::Load(data);
+        typename O::Reg max_reg = min_reg;
+        for (i = O::WIDTH; i + O::WIDTH <= n; i += O::WIDTH) {
+            const typename O::Reg values = O::Load(data + i);
+            min_reg = O::Min(min_reg, values);
+            max_reg = O::Max(max_reg, values);
+        }
+        min = O::HorizontalMin(min_reg);
+        max = O::HorizontalMax(max_reg);
+    }
+    for (; i < n; ++i) {
+        min = data[i] < min ? data[i] : min;
+        max = max < data[i] ? data[i] : max;
+    }
+    return {min, max};
+}
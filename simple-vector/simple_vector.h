@@ -1,17 +1,26 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <functional>
 #include <stdexcept>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 #include "array_ptr.h"
+#include "growth_policy.h"
+#include "instrumentation.h"
+#include "simd_algorithms.h"
 
 class ReserveProxyObj {
 public:
-    explicit ReserveProxyObj(size_t capacity_to_reserve)
+    constexpr explicit ReserveProxyObj(size_t capacity_to_reserve)
     : capacity_to_reserve_(capacity_to_reserve) {
     }
 
-    size_t GetCapacity() const {
+    constexpr size_t GetCapacity() const {
         return capacity_to_reserve_;
     }
 
@@ -19,73 +28,187 @@ private:
     size_t capacity_to_reserve_;
 };
 
-ReserveProxyObj Reserve(size_t capacity_to_reserve) {
+constexpr ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj(capacity_to_reserve);
-}; 
+};
+
+// Признак типа, который можно переместить в другую память побайтовым копированием,
+// не вызывая у исходного объекта деструктор. Для таких типов SimpleVector
+// переносит элементы через memcpy/memmove вместо поэлементного перемещения.
+// По умолчанию истинен для тривиально копируемых типов; пользовательский тип
+// (например, владеющий указателем) может включить его специализацией:
+//     template <> struct IsTriviallyRelocatable<MyType> : std::true_type {};
+template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {
+};
+
+template <typename Type>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<Type>::value;
+
+// Аллокатор с собственными construct/destroy нельзя обходить побайтовым копированием
+template <typename Type, typename Allocator, typename = void>
+struct AllocatorHasCustomConstruct : std::false_type {
+};
+
+template <typename Type, typename Allocator>
+struct AllocatorHasCustomConstruct<Type, Allocator, std::void_t<decltype(std::declval<Allocator&>().construct(
+                                                        std::declval<Type*>(), std::declval<Type&&>()))>>
+    : std::true_type {
+};
+
+template <typename Type, typename Allocator, typename = void>
+struct AllocatorHasCustomDestroy : std::false_type {
+};
+
+template <typename Type, typename Allocator>
+struct AllocatorHasCustomDestroy<Type, Allocator,
+                                 std::void_t<decltype(std::declval<Allocator&>().destroy(std::declval<Type*>()))>>
+    : std::true_type {
+};
 
+// В C++17 std::allocator ещё объявляет construct/destroy, но они сводятся
+// к placement new и вызову деструктора, поэтому обходить их можно
+template <typename Allocator>
+struct IsStdAllocator : std::false_type {
+};
 
 template <typename Type>
+struct IsStdAllocator<std::allocator<Type>> : std::true_type {
+};
+
+// Можно ли переносить элементы Type, выделенные аллокатором Allocator, через memcpy/memmove
+template <typename Type, typename Allocator>
+inline constexpr bool CanRelocateBytewiseV = IsTriviallyRelocatableV<Type>
+    && (IsStdAllocator<Allocator>::value
+        || (!AllocatorHasCustomConstruct<Type, Allocator>::value
+            && !AllocatorHasCustomDestroy<Type, Allocator>::value));
+
+// Является ли Iterator итератором ввода. Отсекает целые числа в перегрузках Insert(pos, count, value)
+template <typename Iterator, typename = void>
+struct IsInputIterator : std::false_type {
+};
+
+template <typename Iterator>
+struct IsInputIterator<Iterator, std::void_t<typename std::iterator_traits<Iterator>::iterator_category>>
+    : std::is_convertible<typename std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag> {
+};
+
+template <typename Iterator>
+inline constexpr bool IsInputIteratorV = IsInputIterator<Iterator>::value;
+
+
+// Динамический массив. Память выделяется аллокатором Allocator,
+// элементы создаются и разрушаются через std::allocator_traits<Allocator>.
+// Новую вместимость при росте и автоматическое сжатие задаёт GrowthPolicy (см. growth_policy.h).
+// Instrumentation получает события выделения памяти и роста (см. instrumentation.h).
+// В C++20 вектор constexpr: его можно заполнять и сравнивать при вычислении на этапе компиляции,
+// но память, выделенная там, должна освободиться там же. Чтобы таблица попала в бинарник,
+// её собирают в SimpleVector внутри constexpr-функции и копируют в StaticVector (см. static_vector.h).
+// С SIMPLE_VECTOR_DEBUG итераторы — CheckedIterator (см. checked_iterator.h), а operator[] проверяет индекс.
+// Отладочный режим строже стандарта: итераторы считаются недействительными после любой вставки,
+// удаления, Resize, Clear, swap и переноса памяти, даже если элементы остались на месте.
+// Исключение — PushBack/EmplaceBack/Append без переноса памяти, как у std::vector.
+// Итераторы, пережившие swap или перемещение вектора, стандарт считает действительными,
+// а отладочный режим — нет: это намеренное ограничение (см. checked_iterator.h)
+template <typename Type, typename Allocator = std::allocator<Type>, typename GrowthPolicy = DoublingGrowth,
+          typename Instrumentation = NoInstrumentation>
 class SimpleVector {
 public:
+#ifdef SIMPLE_VECTOR_DEBUG
+    using Iterator = CheckedIterator<SimpleVector, Type>;
+    using ConstIterator = CheckedIterator<SimpleVector, const Type>;
+#else
     using Iterator = Type*;
     using ConstIterator = const Type*;
+#endif
+    using AllocatorType = Allocator;
+    using GrowthPolicyType = GrowthPolicy;
+    using InstrumentationType = Instrumentation;
 
     SimpleVector() noexcept = default;
 
+    // Создаёт пустой вектор, выделяющий память аллокатором alloc
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(const Allocator& alloc) noexcept
+    : data_(alloc) {
+    }
+
     // Создаёт вектор из size элементов, инициализированных значением по умолчанию
-    explicit SimpleVector(size_t size)
-    : SimpleVector(size, Type{}) {
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(size_t size, const Allocator& alloc = Allocator())
+    : data_(size, alloc) {
+        NoteAllocation();
+        ConstructEach(data_.Get(), size, [this](Type* place, size_t) {
+            Construct(place);
+        });
+        size_ = size;
+        NoteSize();
     }
 
-    SimpleVector(ReserveProxyObj reserve_proxy)
-    :  size_(0), capacity_(reserve_proxy.GetCapacity()), data_(nullptr) {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(ReserveProxyObj reserve_proxy, const Allocator& alloc = Allocator())
+    : data_(reserve_proxy.GetCapacity(), alloc) {
+        NoteAllocation();
     }
-    
 
     // Создаёт вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, Type value)
-    : size_(size), capacity_(size), data_(size) {
-        for(auto it = this->begin(); it != this->end(); ++it){
-            *it = std::move(value);
-        }
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+    : data_(size, alloc) {
+        NoteAllocation();
+        ConstructEach(data_.Get(), size, [this, &value](Type* place, size_t) {
+            Construct(place, value);
+        });
+        size_ = size;
+        NoteSize();
     }
 
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init)
-    : size_(init.size()), capacity_(init.size()), data_(init.size()) {
-        std::copy(std::make_move_iterator(init.begin()),
-                  std::make_move_iterator(init.end()),
-                  data_.Get());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+    : data_(init.size(), alloc) {
+        NoteAllocation();
+        ConstructEach(data_.Get(), init.size(), [this, &init](Type* place, size_t i) {
+            Construct(place, init.begin()[i]);
+        });
+        size_ = init.size();
+        NoteSize();
     }
 
-    SimpleVector(const SimpleVector& other)
-    : size_(other.size_), capacity_(other.capacity_), data_(other.capacity_) {
-        std::copy(std::make_move_iterator(other.begin()),
-                  std::make_move_iterator(other.end()), 
-                  data_.Get());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other)
+    : data_(other.size_, AllocatorTraits::select_on_container_copy_construction(other.GetAllocator())) {
+        NoteAllocation();
+        if (USE_BULK_COPY && !IsConstantEvaluated()) {
+            if (other.size_ != 0) {
+                std::memcpy(static_cast<void*>(data_.Get()), other.data_.Get(), other.size_ * sizeof(Type));
+            }
+        } else {
+            ConstructEach(data_.Get(), other.size_, [this, &other](Type* place, size_t i) {
+                Construct(place, other.data_[i]);
+            });
+        }
+        size_ = other.size_;
+        NoteSize();
     }
 
     // Конструктор перемещения
-    SimpleVector(SimpleVector&& other) noexcept 
-        : size_(other.size_), capacity_(other.capacity_), data_(std::move(other.data_)) {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other) noexcept
+        : size_(other.size_), data_(std::move(other.data_)) {
         other.size_ = 0;
-        other.capacity_ = 0;
+        other.Invalidate();
+    }
+
+    // Разрушает созданные элементы, память освобождает ArrayPtr
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector() {
+        Destroy(data_.Get(), data_.Get() + size_);
+        NoteRelease(size_, GetCapacity());
     }
 
     // Оператор присваивания перемещением
-    SimpleVector& operator=(SimpleVector&& rhs) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept {
         if (this != &rhs) {
-            if (rhs.IsEmpty()) {
-                Clear();
-                return *this;
-            }
             SimpleVector tmp(std::move(rhs));
             swap(tmp);
         }
         return *this;
     }
-    
-    SimpleVector& operator=(const SimpleVector& rhs) {
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs) {
         if (this != &rhs) {
             auto rhs_copy(rhs);
             swap(rhs_copy);
@@ -94,34 +217,57 @@ public:
         return *this;
     }
 
+    // Возвращает аллокатор, которым вектор выделяет память
+    SIMPLE_VECTOR_CONSTEXPR Allocator GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
     // Возвращает количество элементов в массиве
-    size_t GetSize() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
         return size_;
     }
 
     // Возвращает вместимость массива
-    size_t GetCapacity() const noexcept {
-        return capacity_;
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept {
+        return data_.GetSize();
     }
 
     // Сообщает, пустой ли массив
-    bool IsEmpty() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept {
         return size_ == 0;
     }
 
+    // Возвращает указатель на первый элемент. Для пустого вектора может быть nullptr
+    SIMPLE_VECTOR_CONSTEXPR Type* GetData() noexcept {
+        return data_.Get();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type* GetData() const noexcept {
+        return data_.Get();
+    }
+
+#ifdef SIMPLE_VECTOR_DEBUG
+    // Номер поколения: растёт при каждом изменении, после которого итераторы недействительны
+    SIMPLE_VECTOR_CONSTEXPR size_t GetGeneration() const noexcept {
+        return generation_;
+    }
+#endif
+
     // Возвращает ссылку на элемент с индексом index
-    Type& operator[](size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "SimpleVector index is out of range");
         return data_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "SimpleVector index is out of range");
         return data_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    Type& At(size_t index) {
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("Index is out pf range!");
         }
@@ -130,223 +276,676 @@ public:
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    const Type& At(size_t index) const {
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
          if (index >= size_) {
             throw std::out_of_range("Index is out pf range!");
         }
         return data_[index];
     }
 
-    // Обнуляет размер массива, не изменяя его вместимость
-    void Clear() noexcept {
+    // Разрушает все элементы, не изменяя вместимость массива
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        Destroy(data_.Get(), data_.Get() + size_);
         size_ = 0u;
+        Invalidate();
+    }
+
+    // Задает ёмкость вектора.
+    // Если аллокатор умеет расширять блок на месте (см. ArrayPtr::TryExpand), элементы
+    // остаются на месте. Иначе они переносятся в новую память перемещением,
+    // без промежуточного создания объектов по умолчанию в новой ёмкости
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
+        if (new_capacity > GetCapacity()) {
+            Grow(new_capacity, GrowthSource::RESERVE);
+        }
     }
 
-    // Задает ёмкость вектора. 
-    void Reserve(size_t new_capacity) {
-        if (new_capacity > capacity_) {
-            SimpleVector<Type> new_vector(new_capacity);
-            new_vector.size_ = size_;
-            std::copy(std::make_move_iterator(this->begin()),
-                      std::make_move_iterator(this->end()),
-                      new_vector.begin());
-            swap(new_vector);
+    // Уменьшает вместимость до размера. Пустой вектор освобождает память целиком
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() {
+        if (size_ < GetCapacity()) {
+            Reallocate(size_, GrowthSource::SHRINK);
         }
     }
 
     // Изменяет размер массива.
     // При увеличении размера новые элементы получают значение по умолчанию для типа Type
-    void Resize(size_t new_size) {
-        // Если уменьшение размера, то уменьшем только размер контейнера
-        if (new_size == size_) return;
-        if (new_size < size_) {
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        Invalidate();
+        // Если уменьшение размера, то разрушаем лишние элементы
+        if (new_size <= size_) {
+            Destroy(data_.Get() + new_size, data_.Get() + size_);
             size_ = new_size;
+            MaybeShrink();
             return;
         }
 
-        // Если увеличение размера контейнера
-        // то либо дозаполняем контейнер
-        if (new_size > size_ && new_size <= capacity_) {
-            for(auto it = (this->begin() + size_); it != (this->begin() + new_size); ++it){
-                *it = std::move(Type{});
-            }
-            size_ = new_size;
-        }
-        // либо создаём новый массив и производим копирование элементов
-        size_t capacity = std::max(new_size, capacity_ * 2);
-        ArrayPtr<Type> new_arr(capacity); 
-        
-        for(auto it = (new_arr.Get() + size_); it != (new_arr.Get() + new_size); ++it){
-            *it = std::move(Type{});
+        // Если места не хватает, то создаём новый массив и переносим в него элементы
+        if (new_size > GetCapacity()) {
+            Grow(GrowthPolicy::NextCapacity(GetCapacity(), new_size, sizeof(Type)), GrowthSource::RESIZE);
         }
-        std::copy(std::make_move_iterator(this->begin()),
-                  std::make_move_iterator(this->end()),
-                  new_arr.Get());
+        // Дозаполняем контейнер значениями по умолчанию
+        ConstructEach(data_.Get() + size_, new_size - size_, [this](Type* place, size_t) {
+            Construct(place);
+        });
         size_ = new_size;
-        capacity_ = capacity;
-        data_.swap(new_arr);
+        NoteSize();
     }
 
     // Добавляет элемент в конец вектора
     // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(Type item) {
-        if (size_ == 0u && capacity_ == 0u) {
-            capacity_ = 1;
-            ArrayPtr<Type> new_arr(capacity_);
-            new_arr[size_] = std::move(item);
-            ++size_;
-            data_.swap(new_arr);
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Добавляет в конец элементы [first, last).
+    // Для прямых итераторов число элементов считается заранее: память выделяется
+    // не больше одного раза. Однопроходные итераторы добавляются по одному
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last) {
+        InsertRange(GrowthSource::PUSH_BACK, size_, first, last);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Append(std::initializer_list<Type> init) {
+        Append(init.begin(), init.end());
+    }
+
+    // Добавляет в конец count элементов, которые init(dest, count) создаёт в неинициализированной
+    // памяти [dest, dest + count) через аллокатор вектора. init должен создать все элементы
+    // либо, бросив исключение, не оставить ни одного — тогда размер вектора не меняется.
+    // Позволяет заполнять вектор снаружи, например параллельно (см. parallel.h)
+    template <typename InitFn>
+    SIMPLE_VECTOR_CONSTEXPR void AppendWith(size_t count, InitFn init) {
+        if (count == 0) {
             return;
         }
-        
-        // Если контейнер полностью не заполнен
-        if (size_ != capacity_) {
-            data_[size_] = std::move(item);
-            ++size_;
-            return;
+        if (size_ + count > GetCapacity()) {
+            Grow(NextCapacity(count), GrowthSource::PUSH_BACK);
+        }
+        init(data_.Get() + size_, count);
+        size_ += count;
+        NoteSize();
+    }
+
+    // Создаёт элемент в конце вектора прямо в его памяти из аргументов args.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity() && !TryExpand(NextCapacity(), GrowthSource::PUSH_BACK)) {
+            return *EmplaceWithRealloc(GrowthSource::PUSH_BACK, size_, std::forward<Args>(args)...);
         }
-        // Если контейнер заполнен полностью
-        Reserve(capacity_ == 0 ? 1 : capacity_ * 2);
-        // Добавляем элемент
-        data_[size_] = std::move(item);
+        Type* emplaced = data_.Get() + size_;
+        Construct(emplaced, std::forward<Args>(args)...);
         ++size_;
+        NoteSize();
+        return *emplaced;
     }
 
     // Вставляет значение value в позицию pos.
     // Возвращает итератор на вставленное значение
     // Если перед вставкой значения вектор был заполнен полностью,
     // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
-    Iterator Insert(ConstIterator pos, Type value) {
-        auto index = std::distance(this->cbegin(), pos);
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
 
-        if (size_ == 0u && capacity_ == 0u) {
-            if (index != 0) {
-                return this->end();
-            }
-            // Резервируем место для одного элемента
-            Reserve(1);
-            // Вставляем элемент
-            data_[index] = std::move(value); 
-            ++size_;
-            return &data_[index];
-        }
-        // Если контейнер полностью не заполнен
-        if (size_ != capacity_) {
-            std::copy_backward(std::make_move_iterator(this->begin() + index),
-                               std::make_move_iterator(this->end()),
-                               (this->end() + 1));
-            data_[index] = std::move(value);
-            ++size_;
-            return &data_[index];
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Вставляет count копий value перед pos.
+    // Возвращает итератор на первый вставленный элемент или pos, если count == 0
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        const size_t index = IndexOf(pos);
+        assert(index <= size_);
+        Invalidate();
+        return MakeIterator(InsertN(GrowthSource::INSERT, index, count, PointsInto(&value), [this, &value](Type* place, size_t) {
+            Construct(place, value);
+        }));
+    }
+
+    // Вставляет элементы [first, last) перед pos. Диапазон из этого же вектора допустим,
+    // если итераторы — указатели или итераторы вектора (Iterator/ConstIterator).
+    // Для прямых итераторов память выделяется не больше одного раза, а элементы после pos
+    // сдвигаются один раз. Возвращает итератор на первый вставленный элемент или pos
+    template <typename InputIt, typename = std::enable_if_t<IsInputIteratorV<InputIt>>>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        const size_t index = IndexOf(pos);
+        assert(index <= size_);
+        if constexpr (std::is_same_v<InputIt, Iterator> || std::is_same_v<InputIt, ConstIterator>) {
+            // Итераторы вектора разворачиваются в указатели, чтобы PointsInto распознал
+            // вставку части вектора в самого себя
+            const Type* first_ptr = UnwrapIterator(first);
+            const Type* last_ptr = UnwrapIterator(last);
+            Invalidate();
+            return MakeIterator(InsertRange(GrowthSource::INSERT, index, first_ptr, last_ptr));
+        } else {
+            Invalidate();
+            return MakeIterator(InsertRange(GrowthSource::INSERT, index, first, last));
         }
-        // Если вектор полностью заполнился
-        Reserve(capacity_ * 2); // Резервируем в два раза больше места
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, std::initializer_list<Type> init) {
+        return Insert(pos, init.begin(), init.end());
+    }
 
-        // Сдвигаем элементы после индекса вправо
-        std::copy_backward(std::make_move_iterator(this->begin() + index),
-                           std::make_move_iterator(this->end()),
-                           this->end() + 1);
-        data_[index] = std::move(value); // Вставляем новый элемент
-        // Увеличиваем размер
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = IndexOf(pos);
+        assert(index <= size_);
+        Invalidate();
+
+        if (size_ == GetCapacity() && !TryExpand(NextCapacity(), GrowthSource::INSERT)) {
+            return MakeIterator(EmplaceWithRealloc(GrowthSource::INSERT, index, std::forward<Args>(args)...));
+        }
+
+        Type* end = data_.Get() + size_;
+        // Вставка в конец не требует сдвига
+        if (index == size_) {
+            Construct(end, std::forward<Args>(args)...);
+            ++size_;
+            NoteSize();
+            return MakeIterator(end);
+        }
+        if constexpr (USE_BULK_RELOCATION) {
+            if (!IsConstantEvaluated()) {
+                // args могут ссылаться на элементы вектора, поэтому значение создаём до сдвига
+                // во временном буфере, а после сдвига хвоста переносим его побайтово
+                alignas(Type) unsigned char buffer[sizeof(Type)];
+                Construct(reinterpret_cast<Type*>(buffer), std::forward<Args>(args)...);
+                std::memmove(static_cast<void*>(data_.Get() + index + 1), data_.Get() + index,
+                             (size_ - index) * sizeof(Type));
+                std::memcpy(static_cast<void*>(data_.Get() + index), buffer, sizeof(Type));
+                ++size_;
+                NoteSize();
+                return MakeIterator(data_.Get() + index);
+            }
+        }
+        // args могут ссылаться на элементы вектора, поэтому значение создаём до сдвига
+        Type value(std::forward<Args>(args)...);
+        // Последний элемент переносим в неинициализированную ячейку,
+        // а остальные после index сдвигаем вправо присваиванием
+        Construct(end, std::move(*(end - 1)));
         ++size_;
-        return &data_[index];
+        NoteSize();
+        std::move_backward(data_.Get() + index, end - 1, end);
+        data_[index] = std::move(value);
+        return MakeIterator(data_.Get() + index);
     }
 
-     // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
-    void PopBack() noexcept {
+     // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
         if (size_ == 0u) {
             return;
         }
         --size_;
+        AllocatorTraits::destroy(data_.GetAllocator(), data_.Get() + size_);
+        Invalidate();
+        MaybeShrink();
     }
 
     // Удаляет элемент вектора в указанной позиции
-    Iterator Erase(ConstIterator pos) {
-        auto index = std::distance(this->cbegin(), pos);
-        std::copy(std::make_move_iterator(this->begin() + index + 1),
-                 std::make_move_iterator(this->end()), this->begin() + index);
-        --size_;
-        return &data_[index];
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        const size_t index = IndexOf(pos);
+        assert(index < size_);
+        Invalidate();
+        if constexpr (USE_BULK_RELOCATION) {
+            if (!IsConstantEvaluated()) {
+                // Разрушаем удаляемый элемент и сдвигаем хвост влево одним memmove
+                AllocatorTraits::destroy(data_.GetAllocator(), data_.Get() + index);
+                std::memmove(static_cast<void*>(data_.Get() + index), data_.Get() + index + 1,
+                             (size_ - index - 1) * sizeof(Type));
+                --size_;
+                MaybeShrink();
+                return MakeIterator(data_.Get() + index);
+            }
+        }
+        std::move(data_.Get() + index + 1, data_.Get() + size_, data_.Get() + index);
+        PopBack();
+        return MakeIterator(data_.Get() + index);
+    }
+
+    // Удаляет элементы [first, last) одним сдвигом хвоста.
+    // Возвращает итератор на элемент, следовавший за удалёнными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t index = IndexOf(first);
+        const size_t count = IndexOf(last) - index;
+        assert(index + count <= size_);
+        Invalidate();
+        if (count == 0) {
+            return MakeIterator(data_.Get() + index);
+        }
+        Type* erased = data_.Get() + index;
+        if (USE_BULK_RELOCATION && !IsConstantEvaluated()) {
+            Destroy(erased, erased + count);
+            std::memmove(static_cast<void*>(erased), erased + count, (size_ - index - count) * sizeof(Type));
+        } else {
+            Type* new_end = std::move(erased + count, data_.Get() + size_, erased);
+            Destroy(new_end, data_.Get() + size_);
+        }
+        size_ -= count;
+        MaybeShrink();
+        return MakeIterator(data_.Get() + index);
     }
 
     // Обменивает значение с другим вектором
-    void swap(SimpleVector& other) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector& other) noexcept {
         std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
         data_.swap(other.data_);
+        Invalidate();
+        other.Invalidate();
     }
 
 
     // Возвращает итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator begin() noexcept {
-        return data_.Get();
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept {
+        return MakeIterator(data_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator end() noexcept {
-        return data_.Get() + size_;
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept {
+        return MakeIterator(data_.Get() + size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator begin() const noexcept {
-        return data_.Get();
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept {
+        return MakeIterator(data_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator end() const noexcept {
-        return data_.Get() + size_;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
+        return MakeIterator(data_.Get() + size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cbegin() const noexcept {
-        return data_.Get();
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept {
+        return MakeIterator(data_.Get());
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cend() const noexcept {
-        return data_.Get() + size_;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
+        return MakeIterator(data_.Get() + size_);
     }
 private:
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    // Перенос элементов в другую память через memcpy/memmove
+    static constexpr bool USE_BULK_RELOCATION = CanRelocateBytewiseV<Type, Allocator>;
+    // Копирование вектора через memcpy
+    static constexpr bool USE_BULK_COPY = USE_BULK_RELOCATION && std::is_trivially_copyable_v<Type>;
+
+    // Итератор на элемент ptr этого вектора. В обычной сборке — сам указатель
+    SIMPLE_VECTOR_CONSTEXPR Iterator MakeIterator(Type* ptr) noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        return Iterator(ptr, this, generation_);
+#else
+        return ptr;
+#endif
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator MakeIterator(const Type* ptr) const noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        return ConstIterator(ptr, this, generation_);
+#else
+        return ptr;
+#endif
+    }
+
+    // Индекс элемента, на который указывает pos. В отладочном режиме проверяет,
+    // что итератор действителен и принадлежит этому вектору
+    SIMPLE_VECTOR_CONSTEXPR size_t IndexOf(ConstIterator pos) const noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        SIMPLE_VECTOR_CHECK(pos.GetOwner() == this, "iterator of another vector is passed");
+#endif
+        return static_cast<size_t>(UnwrapIterator(pos) - data_.Get());
+    }
+
+    // Делает недействительными итераторы, выданные до изменения вектора (только в отладочном режиме)
+    SIMPLE_VECTOR_CONSTEXPR void Invalidate() noexcept {
+#ifdef SIMPLE_VECTOR_DEBUG
+        ++generation_;
+#endif
+    }
+
+    // Вместимость для вставки ещё count элементов
+    SIMPLE_VECTOR_CONSTEXPR size_t NextCapacity(size_t count = 1) const noexcept {
+        return GrowthPolicy::NextCapacity(GetCapacity(), size_ + count, sizeof(Type));
+    }
+
+    // Увеличивает вместимость до new_capacity: на месте, если аллокатор это умеет, иначе переносом
+    SIMPLE_VECTOR_CONSTEXPR void Grow(size_t new_capacity, GrowthSource source) {
+        if (!TryExpand(new_capacity, source)) {
+            Reallocate(new_capacity, source);
+        }
+    }
+
+    // Расширяет блок аллокатором без переноса элементов (см. ArrayPtr::TryExpand)
+    SIMPLE_VECTOR_CONSTEXPR bool TryExpand(size_t new_capacity, GrowthSource source) noexcept {
+        const size_t old_capacity = GetCapacity();
+        if (!data_.TryExpand(new_capacity)) {
+            return false;
+        }
+        if (!IsConstantEvaluated()) {
+            Instrumentation::template OnGrowth<Type>(source, old_capacity, new_capacity, true);
+        }
+        return true;
+    }
+
+    // Переносит элементы в новую память вместимостью new_capacity >= size_
+    SIMPLE_VECTOR_CONSTEXPR void Reallocate(size_t new_capacity, GrowthSource source) {
+        ArrayPtr<Type, Allocator> new_data(new_capacity, data_.GetAllocator());
+        RelocateTo(data_.Get(), data_.Get() + size_, new_data.Get());
+        DestroyRelocated(data_.Get(), data_.Get() + size_);
+        data_.swap(new_data);
+        Invalidate();
+        NoteReallocation(source, new_data.GetSize(), size_);
+    }
+
+    // Сообщения Instrumentation. С NoInstrumentation вызовы пустые и исчезают после встраивания.
+    // На этапе компиляции сообщения не отправляются
+    SIMPLE_VECTOR_CONSTEXPR void NoteAllocation() noexcept {
+        if (GetCapacity() != 0 && !IsConstantEvaluated()) {
+            Instrumentation::template OnAllocate<Type>(GetCapacity());
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void NoteRelease(size_t size, size_t capacity) noexcept {
+        if (capacity != 0 && !IsConstantEvaluated()) {
+            Instrumentation::template OnRelease<Type>(size, capacity);
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void NoteSize() noexcept {
+        if (!IsConstantEvaluated()) {
+            Instrumentation::template OnSize<Type>(size_, GetCapacity());
+        }
+    }
+
+    // Данные уже в новом буфере; old_size элементов перенесено из буфера вместимостью old_capacity
+    SIMPLE_VECTOR_CONSTEXPR void NoteReallocation(GrowthSource source, size_t old_capacity, size_t old_size) noexcept {
+        if (IsConstantEvaluated()) {
+            return;
+        }
+        Instrumentation::template OnGrowth<Type>(source, old_capacity, GetCapacity(), false);
+        NoteAllocation();
+        Instrumentation::template OnRelocate<Type>(old_size);
+        NoteRelease(old_size, old_capacity);
+    }
+
+    // Отдаёт лишнюю память, если этого требует политика роста.
+    // Сжатие — необязательная оптимизация: если перенос элементов не удался,
+    // вектор остаётся с прежней вместимостью
+    SIMPLE_VECTOR_CONSTEXPR void MaybeShrink() noexcept {
+        if constexpr (GrowthPolicy::AUTO_SHRINK) {
+            const size_t new_capacity = GrowthPolicy::ShrinkCapacity(size_, GetCapacity());
+            if (new_capacity < GetCapacity()) {
+                try {
+                    Reallocate(std::max(new_capacity, size_), GrowthSource::SHRINK);
+                } catch (...) {
+                }
+            }
+        }
+    }
+
+    // Создаёт элемент в неинициализированной памяти place через аллокатор
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR void Construct(Type* place, Args&&... args) {
+        AllocatorTraits::construct(data_.GetAllocator(), place, std::forward<Args>(args)...);
+    }
+
+    // Разрушает элементы [first, last) через аллокатор
+    SIMPLE_VECTOR_CONSTEXPR void Destroy(Type* first, Type* last) noexcept {
+        for (; first != last; ++first) {
+            AllocatorTraits::destroy(data_.GetAllocator(), first);
+        }
+    }
+
+    // Создаёт count элементов начиная с dest, вызывая construct(place, i) для каждого.
+    // Если создание очередного элемента бросает исключение, уже созданные разрушаются
+    template <typename ConstructFn>
+    SIMPLE_VECTOR_CONSTEXPR void ConstructEach(Type* dest, size_t count, ConstructFn construct) {
+        size_t i = 0;
+        try {
+            for (; i < count; ++i) {
+                construct(dest + i, i);
+            }
+        } catch (...) {
+            Destroy(dest, dest + i);
+            throw;
+        }
+    }
+
+    // Собирает новый массив увеличенной вместимости: элемент из args создаётся
+    // сразу на позиции index, а остальные элементы переносятся вокруг него
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type* EmplaceWithRealloc(GrowthSource source, size_t index, Args&&... args) {
+        return InsertNWithRealloc(source, index, 1, [&](Type* place, size_t) {
+            Construct(place, std::forward<Args>(args)...);
+        });
+    }
+
+    // Собирает новый массив на size_ + count элементов: новые элементы создаются
+    // вызовами construct(place, i) сразу на позициях [index, index + count),
+    // остальные переносятся вокруг них. При исключении вектор не меняется
+    template <typename ConstructFn>
+    SIMPLE_VECTOR_CONSTEXPR Type* InsertNWithRealloc(GrowthSource source, size_t index, size_t count, ConstructFn construct) {
+        ArrayPtr<Type, Allocator> new_data(NextCapacity(count), data_.GetAllocator());
+        Type* inserted = new_data.Get() + index;
+        ConstructEach(inserted, count, construct);
+        try {
+            RelocateTo(data_.Get(), data_.Get() + index, new_data.Get());
+            try {
+                RelocateTo(data_.Get() + index, data_.Get() + size_, inserted + count);
+            } catch (...) {
+                Destroy(new_data.Get(), new_data.Get() + index);
+                throw;
+            }
+        } catch (...) {
+            Destroy(inserted, inserted + count);
+            throw;
+        }
+        DestroyRelocated(data_.Get(), data_.Get() + size_);
+        data_.swap(new_data);
+        Invalidate();
+        NoteReallocation(source, new_data.GetSize(), size_);
+        size_ += count;
+        NoteSize();
+        return inserted;
+    }
+
+    // Вставляет count элементов в позицию index, создавая i-й вызовом construct(place, i).
+    // Память выделяется не больше одного раза, хвост сдвигается один раз.
+    // may_alias — исходные значения могут лежать в самом векторе, и сдвигать хвост
+    // до их копирования нельзя
+    template <typename ConstructFn>
+    SIMPLE_VECTOR_CONSTEXPR Type* InsertN(GrowthSource source, size_t index, size_t count,
+                                             [[maybe_unused]] bool may_alias, ConstructFn construct) {
+        if (count == 0) {
+            return data_.Get() + index;
+        }
+        if (size_ + count > GetCapacity() && !TryExpand(NextCapacity(count), source)) {
+            return InsertNWithRealloc(source, index, count, construct);
+        }
+        Type* end = data_.Get() + size_;
+        if constexpr (USE_BULK_RELOCATION) {
+            if (!may_alias && !IsConstantEvaluated()) {
+                // Сдвигаем хвост одним memmove и создаём элементы в освободившемся месте.
+                // Если создание бросит исключение, хвост возвращается обратно
+                Type* place = data_.Get() + index;
+                const size_t tail_bytes = (size_ - index) * sizeof(Type);
+                std::memmove(static_cast<void*>(place + count), place, tail_bytes);
+                try {
+                    ConstructEach(place, count, construct);
+                } catch (...) {
+                    std::memmove(static_cast<void*>(place), place + count, tail_bytes);
+                    throw;
+                }
+                size_ += count;
+                NoteSize();
+                return place;
+            }
+        }
+        // Создаём элементы в конце, пока исходные значения на месте, и поворачиваем их к index
+        ConstructEach(end, count, construct);
+        size_ += count;
+        NoteSize();
+        std::rotate(data_.Get() + index, end, data_.Get() + size_);
+        return data_.Get() + index;
+    }
+
+    // Вставляет [first, last) в позицию index
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR Type* InsertRange(GrowthSource source, size_t index, InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::random_access_iterator_tag>) {
+            // Доступ по индексу не меняет итератор, и цикл создания элементов векторизуется
+            const size_t count = static_cast<size_t>(last - first);
+            return InsertN(source, index, count, PointsInto(first), [this, first](Type* place, size_t i) {
+                Construct(place, first[i]);
+            });
+        } else if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            return InsertN(source, index, count, PointsInto(first), [this, &first](Type* place, size_t) {
+                Construct(place, *first);
+                ++first;
+            });
+        } else {
+            // Число элементов заранее неизвестно: добавляем их в конец и поворачиваем на место.
+            // При исключении добавленные элементы разрушаются
+            const size_t old_size = size_;
+            try {
+                for (; first != last; ++first) {
+                    EmplaceBack(*first);
+                }
+            } catch (...) {
+                Destroy(data_.Get() + old_size, data_.Get() + size_);
+                size_ = old_size;
+                throw;
+            }
+            std::rotate(data_.Get() + index, data_.Get() + old_size, data_.Get() + size_);
+            return data_.Get() + index;
+        }
+    }
+
+    // Указывает ли итератор на элемент этого вектора. Итераторы, не являющиеся указателями,
+    // считаются указывающими в другой контейнер
+    template <typename It>
+    SIMPLE_VECTOR_CONSTEXPR bool PointsInto(const It& it) const noexcept {
+        if constexpr (std::is_convertible_v<It, const Type*>) {
+            const Type* ptr = it;
+            if (IsConstantEvaluated()) {
+                // На этапе компиляции указатели в разные массивы сравниваются только на равенство
+                for (size_t i = 0; i < size_; ++i) {
+                    if (ptr == data_.Get() + i) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+            return std::less_equal<const Type*>{}(data_.Get(), ptr) && std::less<const Type*>{}(ptr, data_.Get() + size_);
+        } else {
+            return false;
+        }
+    }
+
+    // Создаёт в неинициализированной памяти dest копии элементов [first, last).
+    // Перемещает, если перемещение не бросает исключений или тип не копируемый.
+    // Тривиально перемещаемые элементы переносятся одним memcpy
+    SIMPLE_VECTOR_CONSTEXPR void RelocateTo(Type* first, Type* last, Type* dest) {
+        if constexpr (USE_BULK_RELOCATION) {
+            if (!IsConstantEvaluated()) {
+                if (first != last) {
+                    std::memcpy(static_cast<void*>(dest), first, static_cast<size_t>(last - first) * sizeof(Type));
+                }
+                return;
+            }
+        }
+        ConstructEach(dest, static_cast<size_t>(last - first), [this, first](Type* place, size_t i) {
+            if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+                Construct(place, std::move(first[i]));
+            } else {
+                Construct(place, first[i]);
+            }
+        });
+    }
+
+    // Завершает жизнь исходных элементов после RelocateTo.
+    // После побайтового переноса деструкторы не вызываются: объекты уже живут в новой памяти
+    SIMPLE_VECTOR_CONSTEXPR void DestroyRelocated(Type* first, Type* last) noexcept {
+        if (!USE_BULK_RELOCATION || IsConstantEvaluated()) {
+            Destroy(first, last);
+        }
+    }
+
     size_t size_ = 0u;
-    size_t capacity_ = 0u;
-    ArrayPtr<Type> data_;
+    ArrayPtr<Type, Allocator> data_;
+#ifdef SIMPLE_VECTOR_DEBUG
+    size_t generation_ = 0u;
+#endif
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+#ifndef SIMPLE_VECTOR_DEBUG
+// Без отладочного режима итераторы — указатели, и проверки не добавляют ни байта кода
+static_assert(std::is_same_v<SimpleVector<int>::Iterator, int*>);
+static_assert(sizeof(SimpleVector<int>) == sizeof(size_t) + sizeof(ArrayPtr<int>));
+#endif
+
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Instrumentation>
+SIMPLE_VECTOR_CONSTEXPR bool operator==(const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& rhs) {
+    if constexpr (simd::IsSimdElementV<Type>) {
+        if (!IsConstantEvaluated()) {
+            return simd::Equal(lhs, rhs);
+        }
+    }
     return lhs.GetSize() == rhs.GetSize()
         && std::equal(lhs.begin(), lhs.end(),
                       rhs.begin(), rhs.end());
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Instrumentation>
+SIMPLE_VECTOR_CONSTEXPR bool operator!=(const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& rhs) {
     return !(lhs == rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Instrumentation>
+SIMPLE_VECTOR_CONSTEXPR bool operator<(const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                      const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& rhs) {
+    if constexpr (simd::IsSimdElementV<Type>) {
+        if (!IsConstantEvaluated()) {
+            return simd::Compare(lhs, rhs) < 0;
+        }
+    }
     return std::lexicographical_compare(lhs.begin(), lhs.end(),
                                         rhs.begin(), rhs.end());
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Instrumentation>
+SIMPLE_VECTOR_CONSTEXPR bool operator<=(const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& rhs) {
     return !(lhs > rhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Instrumentation>
+SIMPLE_VECTOR_CONSTEXPR bool operator>(const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                      const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& rhs) {
     return rhs < lhs;
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Allocator, typename GrowthPolicy, typename Instrumentation>
+SIMPLE_VECTOR_CONSTEXPR bool operator>=(const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& lhs,
+                       const SimpleVector<Type, Allocator, GrowthPolicy, Instrumentation>& rhs) {
     return !(lhs < rhs);
-} 
\ No newline at end of file
+}
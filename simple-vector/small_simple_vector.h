@@ -0,0 +1,494 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include "simple_vector.h"
+
+// Динамический массив с внутренним буфером на N элементов.
+// Пока размер не превышает N, элементы хранятся внутри объекта и куча не используется;
+// при переполнении элементы переносятся в память, выделенную аллокатором Allocator,
+// и дальше вектор растёт вдвое, как SimpleVector.
+// Интерфейс и семантика перемещения совпадают с SimpleVector, но перемещение
+// вектора с элементами во внутреннем буфере переносит сами элементы
+template <typename Type, size_t N, typename Allocator = std::allocator<Type>>
+class SmallSimpleVector {
+    static_assert(N > 0, "SmallSimpleVector needs a non-empty inline buffer");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+    using AllocatorType = Allocator;
+
+    SmallSimpleVector() noexcept = default;
+
+    // Создаёт пустой вектор, выделяющий память сверх внутреннего буфера аллокатором alloc
+    explicit SmallSimpleVector(const Allocator& alloc) noexcept
+    : alloc_(alloc) {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SmallSimpleVector(size_t size, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        Reserve(size);
+        ConstructEach(data_, size, [this](Type* place, size_t) {
+            Construct(place);
+        });
+        size_ = size;
+    }
+
+    SmallSimpleVector(ReserveProxyObj reserve_proxy, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        Reserve(reserve_proxy.GetCapacity());
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SmallSimpleVector(size_t size, const Type& value, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        Reserve(size);
+        ConstructEach(data_, size, [this, &value](Type* place, size_t) {
+            Construct(place, value);
+        });
+        size_ = size;
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init, const Allocator& alloc = Allocator())
+    : alloc_(alloc) {
+        Reserve(init.size());
+        ConstructEach(data_, init.size(), [this, &init](Type* place, size_t i) {
+            Construct(place, init.begin()[i]);
+        });
+        size_ = init.size();
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other)
+    : alloc_(AllocatorTraits::select_on_container_copy_construction(other.alloc_)) {
+        Reserve(other.size_);
+        ConstructEach(data_, other.size_, [this, &other](Type* place, size_t i) {
+            Construct(place, other.data_[i]);
+        });
+        size_ = other.size_;
+    }
+
+    // Конструктор перемещения. Память в куче забирается у other целиком,
+    // элементы из внутреннего буфера other переносятся поштучно
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>)
+    : alloc_(std::move(other.alloc_)) {
+        StealFrom(other);
+    }
+
+    // Разрушает созданные элементы и освобождает память в куче
+    ~SmallSimpleVector() {
+        Destroy(data_, data_ + size_);
+        FreeHeap();
+    }
+
+    // Оператор присваивания перемещением
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Clear();
+            FreeHeap();
+            alloc_ = std::move(rhs.alloc_);
+            StealFrom(rhs);
+        }
+        return *this;
+    }
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (this != &rhs) {
+            auto rhs_copy(rhs);
+            swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    // Возвращает аллокатор, которым вектор выделяет память в куче
+    Allocator GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Сообщает, хранятся ли элементы во внутреннем буфере
+    bool IsInline() const noexcept {
+        return data_ == InlineData();
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return data_[index];
+    }
+
+    // Разрушает все элементы, не изменяя вместимость массива
+    void Clear() noexcept {
+        Destroy(data_, data_ + size_);
+        size_ = 0u;
+    }
+
+    // Задает ёмкость вектора. Ёмкость не меньше N и внутренний буфер
+    // покидается только при запросе больше N элементов
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            Type* new_data = AllocatorTraits::allocate(alloc_, new_capacity);
+            try {
+                RelocateTo(data_, data_ + size_, new_data);
+            } catch (...) {
+                AllocatorTraits::deallocate(alloc_, new_data, new_capacity);
+                throw;
+            }
+            DestroyRelocated(data_, data_ + size_);
+            ReplaceStorage(new_data, new_capacity);
+        }
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            Destroy(data_ + new_size, data_ + size_);
+            size_ = new_size;
+            return;
+        }
+        if (new_size > capacity_) {
+            Reserve(std::max(new_size, capacity_ * 2));
+        }
+        ConstructEach(data_ + size_, new_size - size_, [this](Type* place, size_t) {
+            Construct(place);
+        });
+        size_ = new_size;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Создаёт элемент в конце вектора прямо в его памяти из аргументов args.
+    // Возвращает ссылку на созданный элемент
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == capacity_) {
+            return *EmplaceWithRealloc(size_, std::forward<Args>(args)...);
+        }
+        Type* emplaced = data_ + size_;
+        Construct(emplaced, std::forward<Args>(args)...);
+        ++size_;
+        return *emplaced;
+    }
+
+    // Вставляет значение value в позицию pos.
+    // Возвращает итератор на вставленное значение
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Создаёт элемент из аргументов args в позиции pos.
+    // Возвращает итератор на созданный элемент
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = static_cast<size_t>(pos - data_);
+        assert(index <= size_);
+
+        if (size_ == capacity_) {
+            return EmplaceWithRealloc(index, std::forward<Args>(args)...);
+        }
+
+        Type* end = data_ + size_;
+        // Вставка в конец не требует сдвига
+        if (index == size_) {
+            Construct(end, std::forward<Args>(args)...);
+            ++size_;
+            return end;
+        }
+        // args могут ссылаться на элементы вектора, поэтому значение создаём до сдвига
+        Type value(std::forward<Args>(args)...);
+        // Последний элемент переносим в неинициализированную ячейку,
+        // а остальные после index сдвигаем вправо присваиванием
+        Construct(end, std::move(*(end - 1)));
+        ++size_;
+        std::move_backward(data_ + index, end - 1, end);
+        data_[index] = std::move(value);
+        return data_ + index;
+    }
+
+    // Удаляет последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        if (size_ == 0u) {
+            return;
+        }
+        --size_;
+        AllocatorTraits::destroy(alloc_, data_ + size_);
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = static_cast<size_t>(pos - data_);
+        assert(index < size_);
+        std::move(data_ + index + 1, data_ + size_, data_ + index);
+        PopBack();
+        return data_ + index;
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        SmallSimpleVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    static constexpr bool USE_BULK_RELOCATION = CanRelocateBytewiseV<Type, Allocator>;
+
+    Type* InlineData() noexcept {
+        return reinterpret_cast<Type*>(inline_buffer_);
+    }
+
+    const Type* InlineData() const noexcept {
+        return reinterpret_cast<const Type*>(inline_buffer_);
+    }
+
+    size_t NextCapacity() const noexcept {
+        return capacity_ * 2;
+    }
+
+    template <typename... Args>
+    void Construct(Type* place, Args&&... args) {
+        AllocatorTraits::construct(alloc_, place, std::forward<Args>(args)...);
+    }
+
+    void Destroy(Type* first, Type* last) noexcept {
+        for (; first != last; ++first) {
+            AllocatorTraits::destroy(alloc_, first);
+        }
+    }
+
+    // Создаёт count элементов начиная с dest; при исключении разрушает уже созданные
+    template <typename ConstructFn>
+    void ConstructEach(Type* dest, size_t count, ConstructFn construct) {
+        size_t i = 0;
+        try {
+            for (; i < count; ++i) {
+                construct(dest + i, i);
+            }
+        } catch (...) {
+            Destroy(dest, dest + i);
+            throw;
+        }
+    }
+
+    // Создаёт в dest копии элементов [first, last) так же, как SimpleVector:
+    // memcpy для тривиально перемещаемых типов, иначе перемещение или копирование
+    void RelocateTo(Type* first, Type* last, Type* dest) {
+        if constexpr (USE_BULK_RELOCATION) {
+            if (first != last) {
+                std::memcpy(static_cast<void*>(dest), first, static_cast<size_t>(last - first) * sizeof(Type));
+            }
+            return;
+        }
+        ConstructEach(dest, static_cast<size_t>(last - first), [this, first](Type* place, size_t i) {
+            if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+                Construct(place, std::move(first[i]));
+            } else {
+                Construct(place, first[i]);
+            }
+        });
+    }
+
+    void DestroyRelocated(Type* first, Type* last) noexcept {
+        if constexpr (!USE_BULK_RELOCATION) {
+            Destroy(first, last);
+        }
+    }
+
+    // Освобождает память в куче, если элементы хранятся там. Элементы должны быть разрушены
+    void FreeHeap() noexcept {
+        if (!IsInline()) {
+            AllocatorTraits::deallocate(alloc_, data_, capacity_);
+            data_ = InlineData();
+            capacity_ = N;
+        }
+    }
+
+    // Переключается на память new_data, в которую уже перенесены элементы
+    void ReplaceStorage(Type* new_data, size_t new_capacity) noexcept {
+        FreeHeap();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    // Забирает элементы пустого other: память в куче целиком, внутренний буфер — поштучно
+    void StealFrom(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (other.IsInline()) {
+            RelocateTo(other.data_, other.data_ + other.size_, data_);
+            size_ = other.size_;
+            other.DestroyRelocated(other.data_, other.data_ + other.size_);
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            other.data_ = other.InlineData();
+            other.capacity_ = N;
+        }
+        other.size_ = 0;
+    }
+
+    // Собирает новый массив увеличенной вместимости: элемент из args создаётся
+    // сразу на позиции index, а остальные элементы переносятся вокруг него
+    template <typename... Args>
+    Iterator EmplaceWithRealloc(size_t index, Args&&... args) {
+        const size_t new_capacity = NextCapacity();
+        Type* new_data = AllocatorTraits::allocate(alloc_, new_capacity);
+        Type* emplaced = new_data + index;
+        try {
+            Construct(emplaced, std::forward<Args>(args)...);
+            try {
+                RelocateTo(data_, data_ + index, new_data);
+                try {
+                    RelocateTo(data_ + index, data_ + size_, emplaced + 1);
+                } catch (...) {
+                    Destroy(new_data, new_data + index);
+                    throw;
+                }
+            } catch (...) {
+                AllocatorTraits::destroy(alloc_, emplaced);
+                throw;
+            }
+        } catch (...) {
+            AllocatorTraits::deallocate(alloc_, new_data, new_capacity);
+            throw;
+        }
+        DestroyRelocated(data_, data_ + size_);
+        ReplaceStorage(new_data, new_capacity);
+        ++size_;
+        return emplaced;
+    }
+
+    Type* data_ = InlineData();
+    size_t size_ = 0u;
+    size_t capacity_ = N;
+    [[no_unique_address]] Allocator alloc_{};
+    alignas(Type) unsigned char inline_buffer_[N * sizeof(Type)];
+};
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator==(const SmallSimpleVector<Type, N, Allocator>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    if constexpr (simd::IsSimdElementV<Type>) {
+        return simd::Equal(lhs, rhs);
+    } else {
+        return lhs.GetSize() == rhs.GetSize()
+            && std::equal(lhs.begin(), lhs.end(),
+                          rhs.begin(), rhs.end());
+    }
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator!=(const SmallSimpleVector<Type, N, Allocator>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<(const SmallSimpleVector<Type, N, Allocator>& lhs,
+                      const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    if constexpr (simd::IsSimdElementV<Type>) {
+        return simd::Compare(lhs, rhs) < 0;
+    } else {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                                            rhs.begin(), rhs.end());
+    }
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator<=(const SmallSimpleVector<Type, N, Allocator>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(lhs > rhs);
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>(const SmallSimpleVector<Type, N, Allocator>& lhs,
+                      const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, size_t N, typename Allocator>
+inline bool operator>=(const SmallSimpleVector<Type, N, Allocator>& lhs,
+                       const SmallSimpleVector<Type, N, Allocator>& rhs) {
+    return !(lhs < rhs);
+}
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Непрерывный столбец SoaVector: указатель и длина. Как и SimpleVector, отдаёт begin() и GetSize(),
+// поэтому годится для simd:: и parallel:: алгоритмов. Изменение размера вектора делает его недействительным
+template <typename T>
+class ColumnSpan {
+public:
+    ColumnSpan(T* data, size_t size) noexcept
+    : data_(data), size_(size) {
+    }
+
+    T* begin() const noexcept {
+        return data_;
+    }
+
+    T* end() const noexcept {
+        return data_ + size_;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        return data_[index];
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+// Индекс типа T среди Types; T должен встречаться ровно один раз
+template <typename T, typename... Types>
+constexpr size_t IndexOfType() noexcept {
+    constexpr bool matches[] = {std::is_same_v<T, Types>...};
+    size_t index = sizeof...(Types);
+    size_t count = 0;
+    for (size_t i = 0; i < sizeof...(Types); ++i) {
+        if (matches[i]) {
+            index = i;
+            ++count;
+        }
+    }
+    return count == 1 ? index : sizeof...(Types);
+}
+
+// Ссылка на строку SoaVector: набор ссылок на поля строки в разных столбцах.
+// Refs — Fields& или const Fields&. Присваивание записывает значения в поля,
+// преобразование в Value копирует строку. Поля читаются через Get<I>(), Get<Field>()
+// или структурное связывание: auto [x, y] = v[i] связывает x и y с полями строки
+template <typename... Refs>
+class SoaReference {
+public:
+    using Value = std::tuple<std::decay_t<Refs>...>;
+
+    explicit SoaReference(Refs... refs) noexcept
+    : refs_(refs...) {
+    }
+
+    // Ссылка на изменяемую строку приводится к ссылке на константную
+    template <typename... Others,
+              typename = std::enable_if_t<!std::is_same_v<SoaReference<Others...>, SoaReference> &&
+                                          std::is_constructible_v<std::tuple<Refs...>, const std::tuple<Others...>&>>>
+    SoaReference(const SoaReference<Others...>& other) noexcept
+    : refs_(other.refs_) {
+    }
+
+    SoaReference(const SoaReference&) noexcept = default;
+
+    // Записывает значения полей другой строки, а не перенаправляет ссылки
+    SoaReference& operator=(const SoaReference& other) {
+        refs_ = other.refs_;
+        return *this;
+    }
+
+    SoaReference& operator=(const Value& value) {
+        refs_ = value;
+        return *this;
+    }
+
+    SoaReference& operator=(Value&& value) {
+        refs_ = std::move(value);
+        return *this;
+    }
+
+    template <size_t I>
+    std::tuple_element_t<I, std::tuple<Refs...>> Get() const noexcept {
+        return std::get<I>(refs_);
+    }
+
+    template <typename Field>
+    decltype(auto) Get() const noexcept {
+        constexpr size_t index = IndexOfType<Field, std::decay_t<Refs>...>();
+        static_assert(index < sizeof...(Refs), "Field type must occur exactly once");
+        return Get<index>();
+    }
+
+    operator Value() const {
+        return Value(refs_);
+    }
+
+    friend bool operator==(const SoaReference& lhs, const Value& rhs) {
+        return lhs.refs_ == rhs;
+    }
+
+    friend bool operator!=(const SoaReference& lhs, const Value& rhs) {
+        return !(lhs == rhs);
+    }
+
+    // Обменивает значения полей двух строк
+    friend void swap(SoaReference lhs, SoaReference rhs) {
+        SwapFields(lhs, rhs, std::index_sequence_for<Refs...>());
+    }
+
+private:
+    template <typename...>
+    friend class SoaReference;
+
+    template <size_t... Is>
+    static void SwapFields(SoaReference& lhs, SoaReference& rhs, std::index_sequence<Is...>) {
+        using std::swap;
+        (swap(std::get<Is>(lhs.refs_), std::get<Is>(rhs.refs_)), ...);
+    }
+
+    std::tuple<Refs...> refs_;
+};
+
+// Для структурного связывания
+template <size_t I, typename... Refs>
+decltype(auto) get(const SoaReference<Refs...>& ref) noexcept {
+    return ref.template Get<I>();
+}
+
+template <typename... Refs>
+struct std::tuple_size<SoaReference<Refs...>> : std::integral_constant<size_t, sizeof...(Refs)> {
+};
+
+template <size_t I, typename... Refs>
+struct std::tuple_element<I, SoaReference<Refs...>> {
+    using type = std::tuple_element_t<I, std::tuple<Refs...>>;
+};
+
+// Вектор записей из полей Fields..., где каждое поле хранится в своём SimpleVector.
+// Цикл по одному полю читает только его столбец и не тратит кэш на остальные поля.
+// Column<I>() и Column<Field>() отдают столбец как непрерывный массив (ColumnSpan).
+// PushBack, EmplaceBack, Insert, Erase, Reserve и Resize работают как у SimpleVector;
+// если операция над одним столбцом бросит исключение, уже изменённые столбцы
+// возвращаются к прежнему размеру и содержимому
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector needs at least one field");
+
+    template <bool IsConst>
+    class BasicIterator;
+
+public:
+    using Value = std::tuple<Fields...>;
+    using Reference = SoaReference<Fields&...>;
+    using ConstReference = SoaReference<const Fields&...>;
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, Value>;
+
+    SoaVector() noexcept = default;
+
+    // Создаёт вектор из size строк со значениями по умолчанию
+    explicit SoaVector(size_t size) {
+        Resize(size);
+    }
+
+    SoaVector(std::initializer_list<Value> init) {
+        Reserve(init.size());
+        for (const Value& value : init) {
+            PushBack(value);
+        }
+    }
+
+    size_t GetSize() const noexcept {
+        return std::get<0>(columns_).GetSize();
+    }
+
+    // Вместимость — наименьшая из вместимостей столбцов
+    size_t GetCapacity() const noexcept {
+        return std::apply([](const auto&... columns) {
+            return std::min({columns.GetCapacity()...});
+        }, columns_);
+    }
+
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    Reference operator[](size_t index) noexcept {
+        return std::apply([index](auto&... columns) {
+            return Reference(columns[index]...);
+        }, columns_);
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        return std::apply([index](const auto&... columns) {
+            return ConstReference(columns[index]...);
+        }, columns_);
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= GetSize()) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return (*this)[index];
+    }
+
+    template <size_t I>
+    ColumnSpan<FieldType<I>> Column() noexcept {
+        auto& column = std::get<I>(columns_);
+        return {column.IsEmpty() ? nullptr : &column[0], column.GetSize()};
+    }
+
+    template <size_t I>
+    ColumnSpan<const FieldType<I>> Column() const noexcept {
+        const auto& column = std::get<I>(columns_);
+        return {column.IsEmpty() ? nullptr : &column[0], column.GetSize()};
+    }
+
+    template <typename Field>
+    ColumnSpan<Field> Column() noexcept {
+        return Column<FieldIndex<Field>()>();
+    }
+
+    template <typename Field>
+    ColumnSpan<const Field> Column() const noexcept {
+        return Column<FieldIndex<Field>()>();
+    }
+
+    void Clear() noexcept {
+        std::apply([](auto&... columns) {
+            (columns.Clear(), ...);
+        }, columns_);
+    }
+
+    void Reserve(size_t new_capacity) {
+        std::apply([new_capacity](auto&... columns) {
+            (columns.Reserve(new_capacity), ...);
+        }, columns_);
+    }
+
+    void Resize(size_t new_size) {
+        const size_t old_size = GetSize();
+        ForEachColumn([new_size](auto& column) {
+            column.Resize(new_size);
+        }, [old_size](auto& column) {
+            column.Resize(old_size);
+        });
+    }
+
+    void PushBack(const Value& value) {
+        ForEachColumn([&value](auto& column, auto index) {
+            column.PushBack(std::get<decltype(index)::value>(value));
+        }, [](auto& column) {
+            column.PopBack();
+        });
+    }
+
+    void PushBack(Value&& value) {
+        ForEachColumn([&value](auto& column, auto index) {
+            column.PushBack(std::get<decltype(index)::value>(std::move(value)));
+        }, [](auto& column) {
+            column.PopBack();
+        });
+    }
+
+    // Добавляет строку, создавая каждое поле из своего аргумента
+    template <typename... Args>
+    Reference EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "EmplaceBack takes one argument per field");
+        auto refs = std::forward_as_tuple(std::forward<Args>(args)...);
+        ForEachColumn([&refs](auto& column, auto index) {
+            column.EmplaceBack(std::get<decltype(index)::value>(std::move(refs)));
+        }, [](auto& column) {
+            column.PopBack();
+        });
+        return (*this)[GetSize() - 1];
+    }
+
+    void PopBack() noexcept {
+        std::apply([](auto&... columns) {
+            (columns.PopBack(), ...);
+        }, columns_);
+    }
+
+    Iterator Insert(ConstIterator pos, const Value& value) {
+        const size_t index = pos - cbegin();
+        ForEachColumn([&value, index](auto& column, auto i) {
+            column.Insert(column.begin() + index, std::get<decltype(i)::value>(value));
+        }, [index](auto& column) {
+            column.Erase(column.begin() + index);
+        });
+        return begin() + index;
+    }
+
+    Iterator Insert(ConstIterator pos, Value&& value) {
+        const size_t index = pos - cbegin();
+        ForEachColumn([&value, index](auto& column, auto i) {
+            column.Insert(column.begin() + index, std::get<decltype(i)::value>(std::move(value)));
+        }, [index](auto& column) {
+            column.Erase(column.begin() + index);
+        });
+        return begin() + index;
+    }
+
+    Iterator Erase(ConstIterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t from = first - cbegin();
+        const size_t to = last - cbegin();
+        std::apply([from, to](auto&... columns) {
+            (columns.Erase(columns.begin() + from, columns.begin() + to), ...);
+        }, columns_);
+        return begin() + from;
+    }
+
+    void swap(SoaVector& other) noexcept {
+        columns_.swap(other.columns_);
+    }
+
+    Iterator begin() noexcept {
+        return Iterator(this, 0);
+    }
+
+    Iterator end() noexcept {
+        return Iterator(this, GetSize());
+    }
+
+    ConstIterator begin() const noexcept {
+        return ConstIterator(this, 0);
+    }
+
+    ConstIterator end() const noexcept {
+        return ConstIterator(this, GetSize());
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    friend bool operator==(const SoaVector& lhs, const SoaVector& rhs) {
+        return lhs.columns_ == rhs.columns_;
+    }
+
+    friend bool operator!=(const SoaVector& lhs, const SoaVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    template <typename Field>
+    static constexpr size_t FieldIndex() noexcept {
+        constexpr size_t index = IndexOfType<Field, Fields...>();
+        static_assert(index < sizeof...(Fields), "Field type must occur exactly once");
+        return index;
+    }
+
+    // Применяет action(column, index) к столбцам по порядку (или action(column), если индекс
+    // не нужен). Если action бросит исключение, к уже изменённым столбцам применяется undo
+    template <size_t I = 0, typename Action, typename Undo>
+    void ForEachColumn(Action action, Undo undo) {
+        if constexpr (I < sizeof...(Fields)) {
+            auto& column = std::get<I>(columns_);
+            if constexpr (std::is_invocable_v<Action&, decltype(column), std::integral_constant<size_t, I>>) {
+                action(column, std::integral_constant<size_t, I>());
+            } else {
+                action(column);
+            }
+            try {
+                ForEachColumn<I + 1>(action, undo);
+            } catch (...) {
+                undo(column);
+                throw;
+            }
+        }
+    }
+
+    // Итератор хранит вектор и номер строки; разыменование возвращает SoaReference
+    template <bool IsConst>
+    class BasicIterator {
+        using Owner = std::conditional_t<IsConst, const SoaVector, SoaVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, ConstReference, Reference>;
+        using pointer = void;
+
+        BasicIterator() noexcept = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+        : owner_(owner), index_(index) {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) noexcept
+        : owner_(other.owner_), index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        reference operator[](difference_type n) const noexcept {
+            return (*owner_)[index_ + n];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator old = *this;
+            --index_;
+            return old;
+        }
+
+        BasicIterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) noexcept {
+            return it += n;
+        }
+
+        friend BasicIterator operator+(difference_type n, BasicIterator it) noexcept {
+            return it += n;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        template <bool>
+        friend class BasicIterator;
+
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    std::tuple<SimpleVector<Fields>...> columns_;
+};
@@ -0,0 +1,386 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "array_ptr.h"
+
+// Хранилище StaticVector для тривиальных типов: обычный массив, заполненный значениями
+// по умолчанию. Всё хранилище — литеральный тип, поэтому вектор можно создавать
+// и изменять на этапе компиляции, а constexpr-переменная попадает в .rodata.
+// Копирование и перемещение тривиальны
+template <typename Type, size_t Capacity, bool Trivial>
+class StaticVectorStorage {
+protected:
+    SIMPLE_VECTOR_CONSTEXPR Type* Data() noexcept {
+        return items_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type* Data() const noexcept {
+        return items_;
+    }
+
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR void Construct(Type* place, Args&&... args) {
+        *place = Type(std::forward<Args>(args)...);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Destroy(Type*) noexcept {
+    }
+
+    Type items_[Capacity] = {};
+    size_t size_ = 0;
+};
+
+// Хранилище для остальных типов: неинициализированная память, элементы создаются на месте
+template <typename Type, size_t Capacity>
+class StaticVectorStorage<Type, Capacity, false> {
+protected:
+    StaticVectorStorage() noexcept = default;
+
+    StaticVectorStorage(const StaticVectorStorage& other) {
+        ConstructFrom(other.Data(), other.size_);
+    }
+
+    StaticVectorStorage(StaticVectorStorage&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        ConstructFrom(std::make_move_iterator(other.Data()), other.size_);
+    }
+
+    // Присваивает общую часть, недостающие элементы создаёт, лишние разрушает
+    StaticVectorStorage& operator=(const StaticVectorStorage& rhs) {
+        if (this != &rhs) {
+            Assign(rhs.Data(), rhs.size_);
+        }
+        return *this;
+    }
+
+    StaticVectorStorage& operator=(StaticVectorStorage&& rhs) noexcept(std::is_nothrow_move_assignable_v<Type> &&
+                                                                       std::is_nothrow_move_constructible_v<Type>) {
+        if (this != &rhs) {
+            Assign(std::make_move_iterator(rhs.Data()), rhs.size_);
+        }
+        return *this;
+    }
+
+    ~StaticVectorStorage() {
+        DestroyAll();
+    }
+
+    Type* Data() noexcept {
+        return std::launder(reinterpret_cast<Type*>(bytes_));
+    }
+
+    const Type* Data() const noexcept {
+        return std::launder(reinterpret_cast<const Type*>(bytes_));
+    }
+
+    template <typename... Args>
+    void Construct(Type* place, Args&&... args) {
+        ::new (static_cast<void*>(place)) Type(std::forward<Args>(args)...);
+    }
+
+    void Destroy(Type* place) noexcept {
+        place->~Type();
+    }
+
+    alignas(Type) unsigned char bytes_[Capacity * sizeof(Type)];
+    size_t size_ = 0;
+
+private:
+    void DestroyAll() noexcept {
+        for (; size_ > 0; --size_) {
+            Destroy(Data() + size_ - 1);
+        }
+    }
+
+    // Создаёт элементы из first[0, count) в пустом хранилище. Деструктор недостроенного
+    // хранилища не вызывается, поэтому при исключении созданные элементы разрушаются здесь
+    template <typename It>
+    void ConstructFrom(It first, size_t count) {
+        try {
+            for (; size_ < count; ++size_) {
+                Construct(Data() + size_, first[size_]);
+            }
+        } catch (...) {
+            DestroyAll();
+            throw;
+        }
+    }
+
+    template <typename It>
+    void Assign(It first, size_t count) {
+        const size_t common = std::min(size_, count);
+        std::copy_n(first, common, Data());
+        for (; size_ < count; ++size_) {
+            Construct(Data() + size_, first[size_]);
+        }
+        for (; size_ > count; --size_) {
+            Destroy(Data() + size_ - 1);
+        }
+    }
+};
+
+// Вектор с вместимостью Capacity во встроенном массиве, без обращений к куче.
+// Интерфейс как у SimpleVector; итераторы — указатели. Добавление сверх вместимости
+// бросает std::bad_alloc и не меняет вектор.
+// В C++20 для тривиальных типов все операции constexpr, и таблицу, собранную на этапе компиляции,
+// можно хранить в constexpr-переменной:
+//     constexpr auto SQUARES = [] {
+//         StaticVector<int, 16> v;
+//         for (int i = 0; i < 16; ++i) v.PushBack(i * i);
+//         return v;
+//     }();
+// Ценой этого массив тривиального типа при создании вектора заполняется нулями
+template <typename Type, size_t Capacity>
+class StaticVector : private StaticVectorStorage<Type, Capacity,
+                                                 std::is_trivially_default_constructible_v<Type> &&
+                                                     std::is_trivially_copyable_v<Type>> {
+    static_assert(Capacity > 0, "StaticVector needs a non-zero capacity");
+
+    using Storage = StaticVectorStorage<Type, Capacity,
+                                        std::is_trivially_default_constructible_v<Type> &&
+                                            std::is_trivially_copyable_v<Type>>;
+    using Storage::Construct;
+    using Storage::Data;
+    using Storage::Destroy;
+    using Storage::size_;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    static constexpr size_t CAPACITY = Capacity;
+
+    SIMPLE_VECTOR_CONSTEXPR StaticVector() noexcept = default;
+
+    SIMPLE_VECTOR_CONSTEXPR explicit StaticVector(size_t size) {
+        Resize(size);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticVector(size_t size, const Type& value) {
+        CheckCapacity(size);
+        while (size_ < size) {
+            Construct(Data() + size_, value);
+            ++size_;
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR StaticVector(std::initializer_list<Type> init) {
+        CheckCapacity(init.size());
+        for (const Type& value : init) {
+            Construct(Data() + size_, value);
+            ++size_;
+        }
+    }
+
+    // Копирует вектор любой вместимости, например собранный на этапе компиляции SimpleVector
+    template <typename Container, typename = decltype(std::declval<const Container&>().GetSize())>
+    SIMPLE_VECTOR_CONSTEXPR explicit StaticVector(const Container& other) {
+        CheckCapacity(other.GetSize());
+        for (const Type& value : other) {
+            Construct(Data() + size_, value);
+            ++size_;
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept {
+        return Capacity;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        return Data()[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        return Data()[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return Data()[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index is out pf range!");
+        }
+        return Data()[index];
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        while (size_ != 0) {
+            PopBack();
+        }
+    }
+
+    // Новые элементы создаются значением по умолчанию. Если конструктор бросит исключение,
+    // созданные элементы разрушаются и размер не меняется
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        CheckCapacity(new_size);
+        const size_t old_size = size_;
+        try {
+            while (size_ < new_size) {
+                Construct(Data() + size_);
+                ++size_;
+            }
+        } catch (...) {
+            while (size_ > old_size) {
+                PopBack();
+            }
+            throw;
+        }
+        while (size_ > new_size) {
+            PopBack();
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        CheckCapacity(size_ + 1);
+        Type* place = Data() + size_;
+        Construct(place, std::forward<Args>(args)...);
+        ++size_;
+        return *place;
+    }
+
+    // Для пустого вектора ничего не делает, как SimpleVector::PopBack
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
+        if (size_ == 0) {
+            return;
+        }
+        --size_;
+        Destroy(Data() + size_);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = static_cast<size_t>(pos - Data());
+        if (index == size_) {
+            return &EmplaceBack(std::forward<Args>(args)...);
+        }
+        CheckCapacity(size_ + 1);
+        // args могут ссылаться на элементы вектора, поэтому значение создаём до сдвига
+        Type value(std::forward<Args>(args)...);
+        Type* end = Data() + size_;
+        Construct(end, std::move(*(end - 1)));
+        ++size_;
+        std::move_backward(Data() + index, end - 1, end);
+        Data()[index] = std::move(value);
+        return Data() + index;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t index = static_cast<size_t>(first - Data());
+        const size_t count = static_cast<size_t>(last - first);
+        std::move(Data() + index + count, Data() + size_, Data() + index);
+        for (size_t i = 0; i < count; ++i) {
+            PopBack();
+        }
+        return Data() + index;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void swap(StaticVector& other) noexcept(std::is_nothrow_move_constructible_v<Type> &&
+                                                      std::is_nothrow_swappable_v<Type>) {
+        StaticVector& shorter = size_ < other.size_ ? *this : other;
+        StaticVector& longer = size_ < other.size_ ? other : *this;
+        std::swap_ranges(shorter.Data(), shorter.Data() + shorter.size_, longer.Data());
+        while (shorter.size_ < longer.size_) {
+            shorter.Construct(shorter.Data() + shorter.size_, std::move(longer.Data()[shorter.size_]));
+            ++shorter.size_;
+            longer.PopBack();
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept {
+        return Data();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept {
+        return Data() + size_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept {
+        return Data();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
+        return Data() + size_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator==(const StaticVector& lhs, const StaticVector& rhs) {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator!=(const StaticVector& lhs, const StaticVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<(const StaticVector& lhs, const StaticVector& rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>(const StaticVector& lhs, const StaticVector& rhs) {
+        return rhs < lhs;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<=(const StaticVector& lhs, const StaticVector& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>=(const StaticVector& lhs, const StaticVector& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    static SIMPLE_VECTOR_CONSTEXPR void CheckCapacity(size_t size) {
+        if (size > Capacity) {
+            throw std::bad_alloc();
+        }
+    }
+};
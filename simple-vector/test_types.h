@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+#include "simple_vector.h"
+
+// Вспомогательные типы, общие для тестов (main.cpp) и бенчмарков (benchmark.cpp)
+
+class X {
+public:
+    X()
+        : X(5) {
+    }
+    X(size_t num)
+        : x_(num) {
+    }
+    X(const X& other) = delete;
+    X& operator=(const X& other) = delete;
+    X(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+    }
+    X& operator=(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+        return *this;
+    }
+    size_t GetX() const {
+        return x_;
+    }
+
+private:
+    size_t x_;
+};
+
+struct TrackedCounters {
+    size_t constructions = 0;
+    size_t copies = 0;
+    size_t moves = 0;
+};
+
+// Тип, считающий конструирования, копирования и перемещения
+struct Tracked {
+    Tracked(int a, int b)
+        : value(a + b) {
+        ++counters.constructions;
+    }
+    Tracked(const Tracked& other)
+        : value(other.value) {
+        ++counters.copies;
+    }
+    Tracked(Tracked&& other) noexcept
+        : value(std::exchange(other.value, 0)) {
+        ++counters.moves;
+    }
+    Tracked& operator=(const Tracked& other) {
+        value = other.value;
+        ++counters.copies;
+        return *this;
+    }
+    Tracked& operator=(Tracked&& other) noexcept {
+        value = std::exchange(other.value, 0);
+        ++counters.moves;
+        return *this;
+    }
+
+    int value;
+    inline static TrackedCounters counters;
+};
+
+// Тип без конструктора по умолчанию, считающий живые объекты
+class Counted {
+public:
+    explicit Counted(int value)
+        : value_(value) {
+        ++alive;
+    }
+    Counted(const Counted& other)
+        : value_(other.value_) {
+        ++alive;
+    }
+    Counted(Counted&& other) noexcept
+        : value_(std::exchange(other.value_, 0)) {
+        ++alive;
+    }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&& other) noexcept {
+        value_ = std::exchange(other.value_, 0);
+        return *this;
+    }
+    ~Counted() {
+        --alive;
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+    inline static int alive = 0;
+
+private:
+    int value_;
+};
+
+// Владеющий указателем тип, явно объявленный тривиально перемещаемым
+struct OwnedInt {
+    explicit OwnedInt(int value)
+        : ptr(std::make_unique<int>(value)) {
+    }
+    std::unique_ptr<int> ptr;
+};
+
+template <>
+struct IsTriviallyRelocatable<OwnedInt> : std::true_type {
+};
+
+// Тривиально копируемый тип, для которого быстрый путь отключён специализацией:
+// на нём измеряется поэлементный перенос
+struct IntNoRelocate {
+    int value;
+};
+
+template <>
+struct IsTriviallyRelocatable<IntNoRelocate> : std::false_type {
+};
+
+// Аллокатор, считающий обращения к куче
+template <typename Type>
+struct CountingAllocator {
+    using value_type = Type;
+
+    CountingAllocator() noexcept = default;
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other>&) noexcept {
+    }
+
+    Type* allocate(size_t n) {
+        ++allocations;
+        return std::allocator<Type>{}.allocate(n);
+    }
+    void deallocate(Type* ptr, size_t n) noexcept {
+        std::allocator<Type>{}.deallocate(ptr, n);
+    }
+
+    inline static size_t allocations = 0;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator==(const CountingAllocator<Lhs>&, const CountingAllocator<Rhs>&) noexcept {
+    return true;
+}
+
+inline SimpleVector<int> GenerateVector(size_t size) {
+    SimpleVector<int> v(size);
+    std::iota(v.begin(), v.end(), 1);
+    return v;
+}
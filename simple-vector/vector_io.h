@@ -0,0 +1,298 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "simple_vector.h"
+
+// Потоковый ввод-вывод SimpleVector через файловые дескрипторы (POSIX).
+// Формат: заголовок VectorStreamHeader, затем элементы.
+// Тривиально копируемые элементы пишутся одним блоком байт вместе с заголовком (writev)
+// и читаются прямо в память вектора. Остальные типы кодируются VectorCodec<Type>
+// как последовательность записей «длина (uint32) + байты»
+
+struct VectorStreamHeader {
+    static constexpr char MAGIC[4] = {'S', 'V', 'I', 'O'};
+
+    char magic[4];
+    // sizeof(Type) для побайтового формата, 0 для записей VectorCodec
+    std::uint32_t element_size;
+    std::uint64_t count;
+};
+
+// Кодирование элемента в байты для типов, которые нельзя писать побайтово.
+// Специализация должна предоставлять
+//     static void Encode(const Type& value, std::string& out) — дописывает байты в out;
+//     static Type Decode(const char* data, size_t size).
+template <typename Type>
+struct VectorCodec;
+
+template <>
+struct VectorCodec<std::string> {
+    static void Encode(const std::string& value, std::string& out) {
+        out.append(value);
+    }
+
+    static std::string Decode(const char* data, size_t size) {
+        return std::string(data, size);
+    }
+};
+
+// Буферизованное чтение из дескриптора. Большие блоки читаются мимо буфера,
+// сразу в память назначения. Буфер может забрать из fd данные, идущие после вектора,
+// поэтому поток после чтения вектора дальше читать через fd нельзя
+class FdReader {
+public:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    explicit FdReader(int fd)
+    : fd_(fd), buffer_(BUFFER_SIZE, '\0') {
+    }
+
+    // Читает ровно size байт в dest. Выбрасывает std::runtime_error при преждевременном конце
+    void ReadExact(void* dest, size_t size) {
+        char* out = static_cast<char*>(dest);
+        const size_t buffered = std::min(size, end_ - begin_);
+        std::memcpy(out, buffer_.data() + begin_, buffered);
+        begin_ += buffered;
+        out += buffered;
+        size -= buffered;
+        if (size == 0) {
+            return;
+        }
+        if (size >= BUFFER_SIZE) {
+            ReadDirect(out, size);
+            return;
+        }
+        Fill(size);
+        std::memcpy(out, buffer_.data(), size);
+        begin_ = size;
+    }
+
+private:
+    // Читает в буфер не меньше min_size байт
+    void Fill(size_t min_size) {
+        begin_ = 0;
+        end_ = 0;
+        while (end_ < min_size) {
+            const ssize_t got = ::read(fd_, buffer_.data() + end_, BUFFER_SIZE - end_);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got < 0) {
+                throw std::system_error(errno, std::generic_category(), "read");
+            }
+            if (got == 0) {
+                throw std::runtime_error("Unexpected end of vector stream");
+            }
+            end_ += static_cast<size_t>(got);
+        }
+    }
+
+    void ReadDirect(char* out, size_t size) {
+        while (size != 0) {
+            const ssize_t got = ::read(fd_, out, size);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            if (got < 0) {
+                throw std::system_error(errno, std::generic_category(), "read");
+            }
+            if (got == 0) {
+                throw std::runtime_error("Unexpected end of vector stream");
+            }
+            out += got;
+            size -= static_cast<size_t>(got);
+        }
+    }
+
+    int fd_;
+    std::string buffer_;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+};
+
+// Пишет все iov целиком, продолжая после частичной записи
+inline void WriteAll(int fd, iovec* iov, int iov_count) {
+    while (iov_count > 0) {
+        const ssize_t written = ::writev(fd, iov, std::min(iov_count, IOV_MAX));
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0) {
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+        size_t left = static_cast<size_t>(written);
+        while (iov_count > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            ++iov;
+            --iov_count;
+        }
+        if (iov_count > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+}
+
+inline void WriteAll(int fd, const void* data, size_t size) {
+    iovec iov{const_cast<void*>(data), size};
+    WriteAll(fd, &iov, 1);
+}
+
+// Читает заголовок потока и проверяет, что он соответствует типу Type
+template <typename Type>
+std::uint64_t ReadVectorStreamHeader(FdReader& reader) {
+    VectorStreamHeader header{};
+    reader.ReadExact(&header, sizeof(header));
+    if (std::memcmp(header.magic, VectorStreamHeader::MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a SimpleVector stream");
+    }
+    const std::uint32_t expected = std::is_trivially_copyable_v<Type> ? sizeof(Type) : 0;
+    if (header.element_size != expected) {
+        throw std::runtime_error("Element size mismatch in SimpleVector stream");
+    }
+    return header.count;
+}
+
+// Записывает вектор в дескриптор fd.
+// Тривиально копируемые элементы уходят вместе с заголовком одним вызовом writev
+template <typename Type, typename... Params>
+void WriteTo(int fd, const SimpleVector<Type, Params...>& v) {
+    VectorStreamHeader header{};
+    std::memcpy(header.magic, VectorStreamHeader::MAGIC, sizeof(header.magic));
+    header.count = v.GetSize();
+
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        header.element_size = sizeof(Type);
+        iovec iov[2] = {
+            {&header, sizeof(header)},
+            {const_cast<Type*>(v.GetData()), v.GetSize() * sizeof(Type)},
+        };
+        WriteAll(fd, iov, v.IsEmpty() ? 1 : 2);
+    } else {
+        header.element_size = 0;
+        constexpr size_t flush_threshold = 1 << 20;
+        std::string buffer(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::string encoded;
+        for (const Type& item : v) {
+            encoded.clear();
+            VectorCodec<Type>::Encode(item, encoded);
+            if (encoded.size() > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::length_error("Encoded element is too large for the vector stream");
+            }
+            const std::uint32_t length = static_cast<std::uint32_t>(encoded.size());
+            buffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            buffer.append(encoded);
+            if (buffer.size() >= flush_threshold) {
+                WriteAll(fd, buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        WriteAll(fd, buffer.data(), buffer.size());
+    }
+}
+
+// Сколько байт элементов ReadElements читает за один шаг. Число элементов в заголовке
+// не проверить, пока не придут сами данные, поэтому память под него не выделяется разом:
+// испорченный заголовок с огромным count стоит не больше одного шага, а не гигабайт
+inline constexpr size_t VECTOR_STREAM_PIECE_BYTES = 16 << 20;
+
+// Читает count элементов из потока в reader и дописывает их в конец v.
+// Для тривиально копируемых типов байты читаются прямо в неинициализированную память вектора
+// (AppendWith), без предварительного заполнения нулями. Память растёт по политике роста v
+// по мере прихода данных, шагами не больше VECTOR_STREAM_PIECE_BYTES.
+// Если поток оборвался или чтение не удалось, v возвращается к прежнему размеру
+template <typename Type, typename... Params>
+void ReadElements(FdReader& reader, SimpleVector<Type, Params...>& v, size_t count) {
+    constexpr size_t piece = std::max<size_t>(1, VECTOR_STREAM_PIECE_BYTES / sizeof(Type));
+    const size_t old_size = v.GetSize();
+    if constexpr (std::is_trivially_copyable_v<Type>) {
+        try {
+            for (size_t left = count; left != 0;) {
+                const size_t n = std::min(left, piece);
+                v.AppendWith(n, [&reader](Type* dest, size_t size) {
+                    reader.ReadExact(dest, size * sizeof(Type));
+                });
+                left -= n;
+            }
+        } catch (...) {
+            v.Resize(old_size);
+            throw;
+        }
+    } else {
+        if (v.IsEmpty()) {
+            v.Reserve(std::min(count, piece));
+        }
+        std::string encoded;
+        try {
+            for (size_t i = 0; i < count; ++i) {
+                std::uint32_t length = 0;
+                reader.ReadExact(&length, sizeof(length));
+                encoded.resize(length);
+                reader.ReadExact(encoded.data(), length);
+                v.PushBack(VectorCodec<Type>::Decode(encoded.data(), length));
+            }
+        } catch (...) {
+            while (v.GetSize() > old_size) {
+                v.PopBack();
+            }
+            throw;
+        }
+    }
+}
+
+// Заменяет содержимое v вектором, прочитанным из дескриптора fd.
+// Вектор читается во временный и подменяет v только после успешного чтения,
+// поэтому при ошибке v не меняется
+template <typename Type, typename... Params>
+void ReadFrom(int fd, SimpleVector<Type, Params...>& v) {
+    FdReader reader(fd);
+    const std::uint64_t count = ReadVectorStreamHeader<Type>(reader);
+    SimpleVector<Type, Params...> read(v.GetAllocator());
+    ReadElements(reader, read, count);
+    v.swap(read);
+}
+
+// Читает поток вектора частями: каждый ReadChunk дописывает в конец вектора
+// не больше max_elements элементов. Память растёт только под прочитанную часть
+template <typename Type>
+class VectorStreamReader {
+public:
+    explicit VectorStreamReader(int fd)
+    : reader_(fd) {
+        remaining_ = ReadVectorStreamHeader<Type>(reader_);
+    }
+
+    // Общее число элементов, ещё не прочитанных из потока
+    std::uint64_t GetRemaining() const noexcept {
+        return remaining_;
+    }
+
+    // Дописывает в v до max_elements элементов. Возвращает их число; 0 — поток закончился
+    template <typename... Params>
+    size_t ReadChunk(SimpleVector<Type, Params...>& v, size_t max_elements) {
+        const size_t count = static_cast<size_t>(std::min<std::uint64_t>(remaining_, max_elements));
+        if (count == 0) {
+            return 0;
+        }
+        ReadElements(reader_, v, count);
+        remaining_ -= count;
+        return count;
+    }
+
+private:
+    FdReader reader_;
+    std::uint64_t remaining_ = 0;
+};